@@ -1,8 +1,10 @@
 #version 330 core
 
 // input data : sent from main program
-layout (location = 0) in vec3 vertexPosition;
+layout (location = 0) in vec2 vertexPosition;
 layout (location = 1) in vec3 vertexColor;
+// per-instance offset for instanced draws; reads (0,0) when not enabled
+layout (location = 2) in vec2 instanceOffset;
 
 uniform mat4 MVP;
 
@@ -11,7 +13,7 @@ out vec3 fragColor;
 
 void main ()
 {
-    vec4 v = vec4(vertexPosition, 1); // Transform an homogeneous 4D vector
+    vec4 v = vec4(vertexPosition + instanceOffset, 0, 1); // Transform an homogeneous 4D vector
 
     // The color of each vertex will be interpolated
     // to produce the color of each fragment
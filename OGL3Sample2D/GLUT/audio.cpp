@@ -0,0 +1,332 @@
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#ifndef NO_ALSA
+#include <alsa/asoundlib.h>
+#endif
+
+#include "audio.h"
+
+/* Little endian fields of a .wav header */
+static int get16 (const unsigned char* p)
+{
+	return (short)(p[0] | p[1]<<8);
+}
+
+static unsigned get32 (const unsigned char* p)
+{
+	return p[0] | p[1]<<8 | p[2]<<16 | (unsigned)p[3]<<24;
+}
+
+static void put16 (unsigned char* p, int v)
+{
+	p[0]=v&0xff;
+	p[1]=(v>>8)&0xff;
+}
+
+static void put32 (unsigned char* p, unsigned v)
+{
+	put16(p,v&0xffff);
+	put16(p+2,v>>16);
+}
+
+/* Decode a 16 bit PCM .wav file and convert it to the output format.
+   Returns the clip id, or -1 if the file can't be used. */
+int AudioMixer::load (const char* path)
+{
+	FILE* f=fopen(path,"rb");
+	if (!f)
+	{
+		fprintf(stderr,"audio: can't open %s\n",path);
+		return -1;
+	}
+	std::vector<unsigned char> buf;
+	unsigned char block[4096];
+	size_t k;
+	while ((k=fread(block,1,sizeof(block),f))>0)
+		buf.insert(buf.end(),block,block+k);
+	fclose(f);
+
+	if (buf.size()<12 || memcmp(&buf[0],"RIFF",4) || memcmp(&buf[8],"WAVE",4))
+	{
+		fprintf(stderr,"audio: %s is not a .wav file\n",path);
+		return -1;
+	}
+
+	/* Walk the chunks for the format and the samples */
+	int format=0, channels=0, bits=0;
+	unsigned rate=0;
+	const unsigned char* data=0;
+	unsigned datalen=0;
+	size_t pos=12;
+	while (pos+8<=buf.size())
+	{
+		/* A chunk header may end the file, leaving body just past the end
+		   with len 0 */
+		const unsigned char* head=buf.data()+pos;
+		const unsigned char* body=head+8;
+		unsigned len=get32(head+4);
+		if (len>buf.size()-pos-8)
+			len=buf.size()-pos-8;
+		if (!memcmp(head,"fmt ",4) && len>=16)
+		{
+			format=get16(body);
+			channels=get16(body+2);
+			rate=get32(body+4);
+			bits=get16(body+14);
+		}
+		if (!memcmp(head,"data",4))
+		{
+			data=body;
+			datalen=len;
+		}
+		pos+=8+len+(len&1);
+	}
+	if (format!=1 || bits!=16 || channels<1 || channels>2 || rate==0 || !data)
+	{
+		fprintf(stderr,"audio: %s is not 16 bit PCM mono or stereo\n",path);
+		return -1;
+	}
+
+	/* Resample to AUDIO_RATE, linearly, and spread mono to both sides */
+	int inframes=datalen/(2*channels);
+	struct AudioClip clip;
+	clip.frames=(int)((long long)inframes*AUDIO_RATE/rate);
+	if (clip.frames==0)
+	{
+		fprintf(stderr,"audio: %s has no samples\n",path);
+		return -1;
+	}
+	clip.pcm.resize(clip.frames*AUDIO_CHANNELS);
+	int i, c;
+	for (i=0;i<clip.frames;i++)
+	{
+		double src=(double)i*rate/AUDIO_RATE;
+		int j=(int)src;
+		double frac=src-j;
+		int j1=j+1<inframes ? j+1 : j;
+		for (c=0;c<AUDIO_CHANNELS;c++)
+		{
+			int ch=c<channels ? c : 0;
+			int a=get16(data+2*(j*channels+ch));
+			int b=get16(data+2*(j1*channels+ch));
+			clip.pcm[i*AUDIO_CHANNELS+c]=(short)(a+(b-a)*frac);
+		}
+	}
+
+	clips.push_back(clip);
+	return (int)clips.size()-1;
+}
+
+/* Start mixing into 's', which the mixer then owns */
+void AudioMixer::start (AudioSink* s)
+{
+	sink=s;
+	running=true;
+	thread=std::thread(&AudioMixer::run,this);
+}
+
+/* Queue a clip to start playing. Never blocks; the request is dropped if
+   the mixer has fallen that far behind. */
+void AudioMixer::play (int clip)
+{
+	if (clip<0 || !running)
+		return;
+	unsigned h=head.load(std::memory_order_relaxed);
+	if (h-tail.load(std::memory_order_acquire)==AUDIO_QUEUE)
+		return;
+	queue[h%AUDIO_QUEUE]=clip;
+	head.store(h+1,std::memory_order_release);
+}
+
+void AudioMixer::stop ()
+{
+	if (!running)
+		return;
+	running=false;
+	thread.join();
+	delete sink;
+	sink=0;
+}
+
+/* Mixer thread: pick up new voices, mix a period, hand it to the sink */
+void AudioMixer::run ()
+{
+	short out[AUDIO_PERIOD*AUDIO_CHANNELS];
+	while (running)
+	{
+		unsigned t=tail.load(std::memory_order_relaxed);
+		unsigned h=head.load(std::memory_order_acquire);
+		for (;t!=h;t++)
+		{
+			if (nvoices==MAX_VOICES)
+				continue;
+			voices[nvoices].clip=queue[t%AUDIO_QUEUE];
+			voices[nvoices].pos=0;
+			nvoices++;
+		}
+		tail.store(t,std::memory_order_release);
+
+		mix(out,AUDIO_PERIOD);
+		sink->write(out,AUDIO_PERIOD);
+	}
+}
+
+/* Sum the playing voices into n frames, dropping voices that finish */
+void AudioMixer::mix (short* out, int n)
+{
+	int acc[AUDIO_PERIOD*AUDIO_CHANNELS];
+	int i, v;
+	memset(acc,0,sizeof(int)*n*AUDIO_CHANNELS);
+
+	for (v=nvoices-1;v>=0;v--)
+	{
+		struct AudioVoice& voice = voices[v];
+		const struct AudioClip& clip = clips[voice.clip];
+		int k=clip.frames-voice.pos;
+		if (k>n)
+			k=n;
+		const short* src=clip.pcm.data()+voice.pos*AUDIO_CHANNELS;
+		for (i=0;i<k*AUDIO_CHANNELS;i++)
+			acc[i]+=src[i];
+		voice.pos+=k;
+		if (voice.pos==clip.frames)
+			voices[v]=voices[--nvoices];
+	}
+
+	for (i=0;i<n*AUDIO_CHANNELS;i++)
+	{
+		int s=acc[i];
+		if (s>32767)
+			s=32767;
+		if (s<-32768)
+			s=-32768;
+		out[i]=(short)s;
+	}
+}
+
+#ifndef NO_ALSA
+/* Default ALSA device */
+struct AlsaSink : AudioSink {
+	snd_pcm_t* pcm;
+
+	void write (const short* frames, int n)
+	{
+		while (n>0)
+		{
+			snd_pcm_sframes_t k=snd_pcm_writei(pcm,frames,n);
+			if (k<0)
+			{
+				/* Underrun or suspend; give up on the period if it persists */
+				if (snd_pcm_recover(pcm,(int)k,1)<0)
+					return;
+				continue;
+			}
+			frames+=k*AUDIO_CHANNELS;
+			n-=k;
+		}
+	}
+
+	~AlsaSink ()
+	{
+		snd_pcm_close(pcm);
+	}
+};
+
+AudioSink* openAlsaSink ()
+{
+	snd_pcm_t* pcm;
+	if (snd_pcm_open(&pcm,"default",SND_PCM_STREAM_PLAYBACK,0)<0)
+		return 0;
+	/* 50ms of buffering, resampled by ALSA if the device needs it */
+	if (snd_pcm_set_params(pcm,SND_PCM_FORMAT_S16_LE,SND_PCM_ACCESS_RW_INTERLEAVED,
+			AUDIO_CHANNELS,AUDIO_RATE,1,50000)<0)
+	{
+		snd_pcm_close(pcm);
+		return 0;
+	}
+	AlsaSink* s=new AlsaSink;
+	s->pcm=pcm;
+	return s;
+}
+#else
+/* Built with -DNO_ALSA, where there is no ALSA (Mac OS X) */
+AudioSink* openAlsaSink ()
+{
+	return 0;
+}
+#endif
+
+/* Consumes audio at the rate a device would, so the mixer runs as it
+   would with a sound card */
+struct NullSink : AudioSink {
+	std::chrono::steady_clock::time_point next;
+
+	NullSink() : next(std::chrono::steady_clock::now()) {}
+
+	void write (const short* frames, int n)
+	{
+		next+=std::chrono::microseconds((long long)n*1000000/AUDIO_RATE);
+		std::this_thread::sleep_until(next);
+	}
+};
+
+AudioSink* openNullSink ()
+{
+	return new NullSink;
+}
+
+/* Paced like NullSink, and keeps everything it is given as a .wav file */
+struct FileSink : NullSink {
+	FILE* f;
+	unsigned frames;
+
+	void write (const short* pcm, int n)
+	{
+		unsigned char buf[AUDIO_PERIOD*AUDIO_CHANNELS*2];
+		int i;
+		for (i=0;i<n*AUDIO_CHANNELS;i++)
+			put16(buf+2*i,pcm[i]);
+		fwrite(buf,2*AUDIO_CHANNELS,n,f);
+		frames+=n;
+		NullSink::write(pcm,n);
+	}
+
+	void header ()
+	{
+		unsigned char h[44];
+		unsigned len=frames*AUDIO_CHANNELS*2;
+		memcpy(h,"RIFF",4);
+		put32(h+4,36+len);
+		memcpy(h+8,"WAVEfmt ",8);
+		put32(h+16,16);
+		put16(h+20,1);
+		put16(h+22,AUDIO_CHANNELS);
+		put32(h+24,AUDIO_RATE);
+		put32(h+28,AUDIO_RATE*AUDIO_CHANNELS*2);
+		put16(h+32,AUDIO_CHANNELS*2);
+		put16(h+34,16);
+		memcpy(h+36,"data",4);
+		put32(h+40,len);
+		fseek(f,0,SEEK_SET);
+		fwrite(h,1,44,f);
+	}
+
+	~FileSink ()
+	{
+		header();
+		fclose(f);
+	}
+};
+
+AudioSink* openFileSink (const char* path)
+{
+	FILE* f=fopen(path,"wb");
+	if (!f)
+		return 0;
+	FileSink* s=new FileSink;
+	s->f=f;
+	s->frames=0;
+	s->header();
+	return s;
+}
@@ -0,0 +1,67 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+
+/* Sound effects, mixed in process on a thread of their own. Clips are
+   decoded and converted to the output format once, when they are loaded;
+   play() only queues a request, so the game thread never waits on audio.
+   Output is 16 bit stereo at AUDIO_RATE. */
+
+#define AUDIO_RATE 44100
+#define AUDIO_CHANNELS 2
+#define AUDIO_PERIOD 512	// frames mixed at a time
+#define MAX_VOICES 16		// clips playing at the same time
+#define AUDIO_QUEUE 64		// play requests not yet picked up by the mixer
+
+/* Where mixed audio goes. write() blocks until the sink is ready for
+   more, which is what paces the mixer. */
+struct AudioSink {
+	virtual ~AudioSink() {}
+	virtual void write(const short* frames, int n) = 0;
+};
+
+AudioSink* openAlsaSink();		// NULL if there is no sound device
+AudioSink* openNullSink();		// discards audio in real time
+AudioSink* openFileSink(const char* path);	// writes a .wav file, NULL on error
+
+struct AudioClip {
+	std::vector<short> pcm;		// interleaved, in the output format
+	int frames;
+};
+
+struct AudioVoice {
+	int clip;
+	int pos;		// next frame to play
+};
+
+struct AudioMixer {
+	std::vector<struct AudioClip> clips;
+	struct AudioVoice voices[MAX_VOICES];
+	int nvoices;
+	AudioSink* sink;
+
+	/* Single producer, single consumer queue of clips to start */
+	int queue[AUDIO_QUEUE];
+	std::atomic<unsigned> head;	// written by play()
+	std::atomic<unsigned> tail;	// written by the mixer thread
+
+	std::thread thread;
+	std::atomic<bool> running;
+
+	AudioMixer() : nvoices(0), sink(0), head(0), tail(0), running(false) {}
+	~AudioMixer() { stop(); }
+
+	int load(const char* path);	// before start(); returns a clip id, or -1
+	void start(AudioSink* s);
+	void play(int clip);
+	void stop();
+
+private:
+	void run();
+	void mix(short* out, int n);
+};
+
+#endif
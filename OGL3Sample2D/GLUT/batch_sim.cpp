@@ -0,0 +1,205 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <vector>
+
+#include "brickworld.h"
+#include "brickbot.h"
+#include "brickpolicy.h"
+#include "threadpool.h"
+
+/* Steps many independent games at once on a work-stealing pool and
+   reports the combined throughput.
+
+   usage: batch_sim [--worlds=N] [--ticks=N] [--threads=N] [--seed=N]
+                    [--policy=aim|random] [--batch=N] [--scaling] [--check]
+
+   --worlds	games to run (default 1024)
+   --ticks	steps per game (default 10000)
+   --threads	workers (default, or 0, one per core)
+   --seed	world i is seeded with seed+i (default 1)
+   --policy	aim: AimPolicy, asked for a batch of worlds at a time
+		random: a RandomBot per world (default aim)
+   --batch	worlds per policy call, and per piece of work (default 64)
+   --scaling	run with 1, 2, 4 ... threads up to --threads and compare
+   --check	run with 1 thread and with --threads, and exit 1 unless the
+		games and total score come out the same
+
+   A game that ends is started again with a new seed. The total score
+   depends only on the options, not on the number of threads. */
+
+struct Batch {
+	std::vector<BrickWorld> worlds;
+	std::vector<RandomBot> bots;
+	std::vector<unsigned long long> seeds;
+	std::vector<long long> scores;	// of the games finished so far
+	std::vector<int> games;
+	BrickPolicy* policy;		// NULL to play with the bots
+	int ticks;
+};
+
+/* Start the next game in world i if the last one is over */
+static void restart (struct Batch* batch, int i)
+{
+	BrickWorld& w = batch->worlds[i];
+	if (!w.gameover)
+		return;
+	batch->scores[i]+=w.score;
+	batch->games[i]++;
+	/* Seeds of later games stay clear of the other worlds' */
+	batch->seeds[i]+=0x100000000ULL;
+	w.init(batch->seeds[i]);
+}
+
+/* Pool task: play worlds [begin, end) to the end, one at a time */
+static void runBots (void* ctx, int begin, int end)
+{
+	struct Batch* batch = (struct Batch*)ctx;
+	BrickInputs in;
+	int i, t;
+	for (i=begin;i<end;i++)
+	{
+		for (t=0;t<batch->ticks;t++)
+		{
+			in.clear();
+			batch->bots[i].inputs(batch->worlds[i],in);
+			batch->worlds[i].step(in);
+			restart(batch,i);
+		}
+	}
+}
+
+/* Pool task: play worlds [begin, end) to the end together, with one
+   policy call per step */
+static void runPolicy (void* ctx, int begin, int end)
+{
+	struct Batch* batch = (struct Batch*)ctx;
+	std::vector<struct BrickObservation> obs(end-begin);
+	std::vector<unsigned> actions(end-begin);
+	int i, t;
+	for (t=0;t<batch->ticks;t++)
+	{
+		stepBatch(&batch->worlds[begin],end-begin,*batch->policy,&obs[0],&actions[0]);
+		for (i=begin;i<end;i++)
+			restart(batch,i);
+	}
+}
+
+/* Play every game once with 'threads' workers; returns the time taken */
+static double runBatch (int worlds, int ticks, int threads, unsigned long long seed, BrickPolicy* policy, int grain,
+	long long* score, long* games)
+{
+	static struct Batch batch;
+	batch.worlds.assign(worlds,BrickWorld());
+	batch.bots.resize(worlds);
+	batch.seeds.resize(worlds);
+	batch.scores.assign(worlds,0);
+	batch.games.assign(worlds,0);
+	batch.policy=policy;
+	batch.ticks=ticks;
+	int i;
+	for (i=0;i<worlds;i++)
+	{
+		batch.seeds[i]=seed+i;
+		batch.worlds[i].init(batch.seeds[i]);
+		batch.bots[i].seed(batch.seeds[i]);
+	}
+
+	ThreadPool pool(threads);
+	std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+	if (policy)
+		pool.parallelFor(worlds,grain,runPolicy,&batch);
+	else
+		pool.parallelFor(worlds,1,runBots,&batch);
+	double secs=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+
+	*score=0;
+	*games=0;
+	for (i=0;i<worlds;i++)
+	{
+		*score+=batch.scores[i]+batch.worlds[i].score;
+		*games+=batch.games[i]+1;
+	}
+	return secs;
+}
+
+int main (int argc, char** argv)
+{
+	int worlds=1024, ticks=10000, threads=0, grain=64;
+	unsigned long long seed=1;
+	bool scaling=false, check=false;
+	AimPolicy aim;
+	BrickPolicy* policy=&aim;
+	int i;
+
+	for (i=1;i<argc;i++)
+	{
+		if (strncmp(argv[i],"--worlds=",9)==0)
+			worlds=atoi(argv[i]+9);
+		else if (strncmp(argv[i],"--ticks=",8)==0)
+			ticks=atoi(argv[i]+8);
+		else if (strncmp(argv[i],"--threads=",10)==0)
+			threads=atoi(argv[i]+10);
+		else if (strncmp(argv[i],"--seed=",7)==0)
+			seed=strtoull(argv[i]+7,0,10);
+		else if (strcmp(argv[i],"--policy=aim")==0)
+			policy=&aim;
+		else if (strcmp(argv[i],"--policy=random")==0)
+			policy=NULL;
+		else if (strncmp(argv[i],"--batch=",8)==0)
+			grain=atoi(argv[i]+8);
+		else if (strcmp(argv[i],"--scaling")==0)
+			scaling=true;
+		else if (strcmp(argv[i],"--check")==0)
+			check=true;
+		else
+		{
+			fprintf(stderr,"usage: %s [--worlds=N] [--ticks=N] [--threads=N] [--seed=N] [--policy=aim|random] [--batch=N] [--scaling] [--check]\n",argv[0]);
+			return 1;
+		}
+	}
+	if (worlds<1 || ticks<1 || grain<1)
+	{
+		fprintf(stderr,"--worlds, --ticks and --batch must be positive\n");
+		return 1;
+	}
+	if (threads<0)
+	{
+		fprintf(stderr,"--threads must be 0 or more, 0 for one per core\n");
+		return 1;
+	}
+	if (threads==0)
+		threads=std::thread::hardware_concurrency()>0 ? std::thread::hardware_concurrency() : 1;
+
+	printf("%d worlds, %d steps each\n",worlds,ticks);
+	printf("%8s %12s %14s %8s %8s %14s\n","threads","time s","steps/s","speedup","games","total score");
+	double base=0;
+	long long firstscore=0;
+	long firstgames=0;
+	bool same=true;
+	int n=scaling || check ? 1 : threads;
+	while (1)
+	{
+		long long score;
+		long games;
+		double secs=runBatch(worlds,ticks,n,seed,policy,grain,&score,&games);
+		if (base==0)
+		{
+			base=secs;
+			firstscore=score;
+			firstgames=games;
+		}
+		same=same && score==firstscore && games==firstgames;
+		printf("%8d %12.3f %14.0f %8.2f %8ld %14lld\n",n,secs,(double)worlds*ticks/secs,base/secs,games,score);
+		if (n>=threads)
+			break;
+		n=check ? threads : (n*2<threads ? n*2 : threads);
+	}
+	if (check)
+	{
+		printf(same ? "ok: the same games on any number of threads\n" : "FAIL: the games depend on the number of threads\n");
+		return same ? 0 : 1;
+	}
+	return 0;
+}
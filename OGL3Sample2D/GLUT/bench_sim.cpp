@@ -0,0 +1,289 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <new>
+
+#include "brickworld.h"
+#include "profile.h"
+#include "brickbot.h"
+#include "hitkernel.h"
+
+/* Runs the game rules without a window for a fixed number of steps, with
+   a bot aiming and firing at random, and reports how long a step takes
+   and how often it allocates.
+
+   usage: bench_sim [--ticks=N] [--bricks=N] [--seed=N] [--profile] [--kernel=N]
+                    [--compare]
+
+   --ticks	steps to run (default 100000)
+   --bricks	bricks in play at a time, roughly (default 13, as in the game)
+   --seed	seed for the world and the bot's commands (default 1)
+   --profile	also time the parts of a step, printed at exit
+   --kernel	instead, time the laser's bulk hit test against N bricks,
+		vector and scalar versions, and check they agree
+   --compare	instead, play the same games with the vector and the scalar
+		hit test and check that every step comes out the same
+
+   A game that ends is started again straight away, with the next seed; the
+   step that ends it is still timed. Runs with the same options play out
+   the same way. */
+
+/* Heap allocations made by anything in the process */
+static unsigned long long allocations;
+
+void* operator new (size_t n)
+{
+	allocations++;
+	void* p=malloc(n ? n : 1);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[] (size_t n)
+{
+	return operator new(n);
+}
+
+void operator delete (void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete[] (void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete (void* p, size_t) noexcept
+{
+	free(p);
+}
+
+void operator delete[] (void* p, size_t) noexcept
+{
+	free(p);
+}
+
+/* Steps between spawns that keep about 'bricks' in play at the starting
+   speed, given a brick falls 6.5 units before it is collected */
+static int spawnInterval (int bricks)
+{
+	int interval=(int)(6.5f/0.01f/bricks);
+	return interval>0 ? interval : 1;
+}
+
+/* Rays from the cannon at random angles against 'n' bricks scattered over
+   the play area, 'ticks' times */
+static int benchKernel (int n, long ticks, unsigned long long seed)
+{
+	typedef std::chrono::steady_clock Clock;
+	static const struct HitBox box={ -0.1f, 3.5f, 0.1f, 3.7f };
+	BrickRandom rng;
+	std::vector<float> x(n), y(n);
+	std::vector<unsigned> mask((n+31)/32), check((n+31)/32);
+	std::vector<struct HitRay> rays(ticks);
+	int i;
+	long t;
+
+	rng.seed(seed);
+	for (i=0;i<n;i++)
+	{
+		x[i]=-3.0f+rng.below(6000)*0.001f;
+		y[i]=-6.5f+rng.below(6500)*0.001f;
+	}
+	for (t=0;t<ticks;t++)
+	{
+		float a=(rng.below(1500)*0.1f-75)*M_PI/180;
+		struct HitRay r={ -3.5f, -3.0f+rng.below(6000)*0.001f, cosf(a), sinf(a), 8.0f };
+		rays[t]=r;
+	}
+
+	long long hits=0, scalarhits=0;
+	long wrong=0;
+	Clock::time_point t0=Clock::now();
+	for (t=0;t<ticks;t++)
+		hits+=rayBoxHits(rays[t],box,&x[0],&y[0],n,&mask[0]);
+	Clock::time_point t1=Clock::now();
+	for (t=0;t<ticks;t++)
+		scalarhits+=rayBoxHitsScalar(rays[t],box,&x[0],&y[0],n,&check[0]);
+	Clock::time_point t2=Clock::now();
+	for (t=0;t<ticks;t++)
+	{
+		rayBoxHits(rays[t],box,&x[0],&y[0],n,&mask[0]);
+		rayBoxHitsScalar(rays[t],box,&x[0],&y[0],n,&check[0]);
+		if (mask!=check)
+			wrong++;
+	}
+
+	double boxes=(double)n*ticks;
+	double vec=std::chrono::duration_cast<std::chrono::nanoseconds>(t1-t0).count();
+	double scalar=std::chrono::duration_cast<std::chrono::nanoseconds>(t2-t1).count();
+	printf("kernel         %s\n",hitKernelName());
+	printf("bricks         %d\n",n);
+	printf("rays           %ld\n",ticks);
+	printf("hits           %lld (scalar %lld)\n",hits,scalarhits);
+	printf("ns/brick       %.3f (scalar %.3f, %.2fx)\n",vec/boxes,scalar/boxes,scalar/vec);
+	printf("mismatches     %ld\n",wrong);
+	return wrong ? 1 : 0;
+}
+
+/* Everything a step decides: the score, the bricks in play, and where the
+   laser is and the whole path it was traced along */
+static unsigned long long stepDigest (const BrickWorld& w)
+{
+	unsigned long long h=14695981039346656037ULL;
+	int i;
+	struct {
+		int score, lives, live, flying, nnodes;
+		float x, y;
+	} s={ w.score, w.lives, w.bricks.live, w.laser.flying, w.laser.nnodes, w.laser.x, w.laser.y };
+	const unsigned char* p=(const unsigned char*)&s;
+	for (i=0;i<(int)sizeof(s);i++)
+		h=(h^p[i])*1099511628211ULL;
+	p=(const unsigned char*)w.laser.path;
+	for (i=0;i<(int)(w.laser.nnodes*sizeof(struct LaserNode));i++)
+		h=(h^p[i])*1099511628211ULL;
+	return h;
+}
+
+/* Play 'ticks' steps as the benchmark does and keep each step's digest */
+static void play (long ticks, int bricks, unsigned long long seed, std::vector<unsigned long long>& digests)
+{
+	static BrickWorld world;
+	RandomBot bot;
+	BrickInputs in;
+	long t, games=1;
+
+	world.init(seed);
+	world.spawninterval=spawnInterval(bricks);
+	bot.seed(seed);
+	digests.resize(ticks);
+	for (t=0;t<ticks;t++)
+	{
+		in.clear();
+		bot.inputs(world,in);
+		world.step(in);
+		digests[t]=stepDigest(world);
+		if (world.gameover)
+		{
+			world.init(seed+games);
+			world.spawninterval=spawnInterval(bricks);
+			games++;
+		}
+	}
+}
+
+/* The same games with the vector hit test and with the scalar one */
+static int compareKernels (long ticks, int bricks, unsigned long long seed)
+{
+	std::vector<unsigned long long> vec, scalar;
+	play(ticks,bricks,seed,vec);
+	forceScalarHits(true);
+	play(ticks,bricks,seed,scalar);
+	forceScalarHits(false);
+
+	long t;
+	for (t=0;t<ticks;t++)
+		if (vec[t]!=scalar[t])
+		{
+			printf("FAIL: %s and scalar hit tests part at step %ld\n",hitKernelName(),t);
+			return 1;
+		}
+	printf("ok: %s and scalar hit tests agree over %ld steps with %d bricks\n",hitKernelName(),ticks,bricks);
+	return 0;
+}
+
+int main (int argc, char** argv)
+{
+	long ticks=100000;
+	int bricks=13, kernel=0;
+	bool compare=false;
+	unsigned long long seed=1;
+	int i;
+
+	for (i=1;i<argc;i++)
+	{
+		if (strncmp(argv[i],"--ticks=",8)==0)
+			ticks=atol(argv[i]+8);
+		else if (strncmp(argv[i],"--bricks=",9)==0)
+			bricks=atoi(argv[i]+9);
+		else if (strncmp(argv[i],"--seed=",7)==0)
+			seed=strtoull(argv[i]+7,0,10);
+		else if (strcmp(argv[i],"--profile")==0)
+			profileStart(NULL);
+		else if (strncmp(argv[i],"--kernel=",9)==0)
+			kernel=atoi(argv[i]+9);
+		else if (strcmp(argv[i],"--compare")==0)
+			compare=true;
+		else
+		{
+			fprintf(stderr,"usage: %s [--ticks=N] [--bricks=N] [--seed=N] [--profile] [--kernel=N] [--compare]\n",argv[0]);
+			return 1;
+		}
+	}
+	if (ticks<1 || bricks<1)
+	{
+		fprintf(stderr,"--ticks and --bricks must be positive\n");
+		return 1;
+	}
+	if (kernel>0)
+		return benchKernel(kernel,ticks,seed);
+	if (compare)
+		return compareKernels(ticks,bricks,seed);
+
+	typedef std::chrono::steady_clock Clock;
+	static BrickWorld world;
+	RandomBot bot;
+	BrickInputs in;
+	std::vector<long long> times(ticks);
+	long games=1, live=0;
+	int score=0;
+
+	world.init(seed);
+	world.spawninterval=spawnInterval(bricks);
+	bot.seed(seed);
+
+	unsigned long long before=allocations;
+	Clock::time_point start=Clock::now();
+	long t;
+	for (t=0;t<ticks;t++)
+	{
+		in.clear();
+		bot.inputs(world,in);
+
+		Clock::time_point t0=Clock::now();
+		world.step(in);
+		Clock::time_point t1=Clock::now();
+		times[t]=std::chrono::duration_cast<std::chrono::nanoseconds>(t1-t0).count();
+
+		live+=world.bricks.live;
+		if (world.gameover)
+		{
+			score+=world.score;
+			world.init(seed+games);
+			world.spawninterval=spawnInterval(bricks);
+			games++;
+		}
+	}
+	Clock::time_point end=Clock::now();
+	unsigned long long allocs=allocations-before;
+	score+=world.score;
+
+	double total=std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count();
+	std::sort(times.begin(),times.end());
+	printf("ticks          %ld\n",ticks);
+	printf("games          %ld\n",games);
+	printf("bricks in play %.1f average\n",(double)live/ticks);
+	printf("score          %d\n",score);
+	printf("ns/tick        %.1f (loop, including the bot)\n",total/ticks);
+	printf("step p50       %lld ns\n",times[ticks/2]);
+	printf("step p99       %lld ns\n",times[(long)(ticks*0.99)]);
+	printf("step max       %lld ns\n",times[ticks-1]);
+	printf("allocs/tick    %.4f (%llu in total)\n",(double)allocs/ticks,allocs);
+	return 0;
+}
@@ -0,0 +1,20 @@
+#include "brickbot.h"
+
+void RandomBot::seed (unsigned long long seed)
+{
+	/* A stream of its own, so it never mirrors a world with the same seed */
+	rng.seed(seed,1);
+}
+
+/* Queue this step's commands */
+void RandomBot::inputs (const BrickWorld& world, BrickInputs& in)
+{
+	unsigned r=rng.next();
+	if (r%8==0)
+		in.push(CMD_AIM,0,-3.2f+(r>>8)%600/100.0f,world.cannon.y+((r>>16)%600)/100.0f-3.0f);
+	if (r%16==1)
+		in.push((r>>4)%2 ? CMD_CANNON_UP : CMD_CANNON_DOWN);
+	if (r%64==2)
+		in.push((r>>4)%2 ? CMD_FASTER : CMD_SLOWER);
+	in.push(CMD_FIRE);
+}
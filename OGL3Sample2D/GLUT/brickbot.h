@@ -0,0 +1,17 @@
+#ifndef BRICKBOT_H
+#define BRICKBOT_H
+
+#include "brickworld.h"
+#include "brickrand.h"
+
+/* A stand-in player for the headless tools: keeps firing, and now and
+   then aims somewhere ahead of the cannon, moves it or changes the speed.
+   It has its own generator, so it plays the same way for the same seed. */
+struct RandomBot {
+	struct BrickRandom rng;
+
+	void seed(unsigned long long seed);
+	void inputs(const BrickWorld& world, BrickInputs& in);
+};
+
+#endif
@@ -0,0 +1,151 @@
+#include <cmath>
+#include <cfloat>
+
+#include "brickgrid.h"
+
+/* Brick boxes, relative to a brick's origin */
+static const float BOX_X0=-0.1f, BOX_X1=0.1f, BOX_Y0=3.5f, BOX_Y1=3.7f;
+
+/* Bucket every live brick by the cells its box overlaps */
+void BrickGrid::build (const BrickPool& bricks)
+{
+	int j, c;
+	float ymin=FLT_MAX, ymax=-FLT_MAX;
+
+	for (j=0;j<bricks.live;j++)
+	{
+		float y=bricks.y[bricks.livelist[j]];
+		if (y<ymin)
+			ymin=y;
+		if (y>ymax)
+			ymax=y;
+	}
+	if (bricks.live==0)
+		ymin=ymax=0;
+
+	/* Lanes sit at multiples of half a unit from -2 to 1.5 */
+	x0=-2.0f-GRID_CELL/2;
+	cols=8;
+	y0=floor((ymin+BOX_Y0)/GRID_CELL)*GRID_CELL;
+	rows=(int)((ymax+BOX_Y1-y0)/GRID_CELL)+1;
+
+	start.assign(cols*rows+1,0);
+	for (j=0;j<bricks.live;j++)
+	{
+		int i=bricks.livelist[j];
+		int r0=(int)((bricks.y[i]+BOX_Y0-y0)/GRID_CELL);
+		int r1=(int)((bricks.y[i]+BOX_Y1-y0)/GRID_CELL);
+		int col=(int)((bricks.x[i]-x0)/GRID_CELL);
+		int r;
+		for (r=r0;r<=r1 && r<rows;r++)
+			start[r*cols+col+1]++;
+	}
+	for (c=0;c<cols*rows;c++)
+		start[c+1]+=start[c];
+
+	items.resize(start[cols*rows]);
+	itemx.resize(items.size());
+	itemy.resize(items.size());
+	fill.assign(start.begin(),start.end()-1);
+	for (j=0;j<bricks.live;j++)
+	{
+		int i=bricks.livelist[j];
+		int r0=(int)((bricks.y[i]+BOX_Y0-y0)/GRID_CELL);
+		int r1=(int)((bricks.y[i]+BOX_Y1-y0)/GRID_CELL);
+		int col=(int)((bricks.x[i]-x0)/GRID_CELL);
+		int r;
+		for (r=r0;r<=r1 && r<rows;r++)
+		{
+			int k=fill[r*cols+col]++;
+			items[k]=i;
+			itemx[k]=bricks.x[i];
+			itemy[k]=bricks.y[i];
+		}
+	}
+}
+
+/* Start walking from (ox,oy) moving (dx,dy) per unit of time, up to tmax */
+void GridWalk::init (const BrickGrid& g, float ox, float oy, float dx, float dy, float tmax)
+{
+	grid=&g;
+	done=true;
+
+	/* Clip the ray to the grid */
+	float x1=g.x0+g.cols*GRID_CELL, y1=g.y0+g.rows*GRID_CELL;
+	float tnear=0, tfar=tmax;
+	if (dx==0)
+	{
+		if (ox<g.x0 || ox>=x1)
+			return;
+	}
+	else
+	{
+		float ta=(g.x0-ox)/dx, tb=(x1-ox)/dx;
+		tnear=fmax(tnear,fmin(ta,tb));
+		tfar=fmin(tfar,fmax(ta,tb));
+	}
+	if (dy==0)
+	{
+		if (oy<g.y0 || oy>=y1)
+			return;
+	}
+	else
+	{
+		float ta=(g.y0-oy)/dy, tb=(y1-oy)/dy;
+		tnear=fmax(tnear,fmin(ta,tb));
+		tfar=fmin(tfar,fmax(ta,tb));
+	}
+	if (tnear>tfar)
+		return;
+
+	float px=ox+dx*tnear, py=oy+dy*tnear;
+	cx=(int)floor((px-g.x0)/GRID_CELL);
+	cy=(int)floor((py-g.y0)/GRID_CELL);
+	if (cx<0)
+		cx=0;
+	if (cx>=g.cols)
+		cx=g.cols-1;
+	if (cy<0)
+		cy=0;
+	if (cy>=g.rows)
+		cy=g.rows-1;
+
+	stepx=dx>0 ? 1 : -1;
+	stepy=dy>0 ? 1 : -1;
+	deltax=dx!=0 ? GRID_CELL/fabs(dx) : FLT_MAX;
+	deltay=dy!=0 ? GRID_CELL/fabs(dy) : FLT_MAX;
+	nextx=dx!=0 ? (g.x0+(cx+(dx>0))*GRID_CELL-ox)/dx : FLT_MAX;
+	nexty=dy!=0 ? (g.y0+(cy+(dy>0))*GRID_CELL-oy)/dy : FLT_MAX;
+	t=tnear;
+	tend=tfar;
+	done=false;
+}
+
+/* Hand out the bricks of the next cell along the ray and the time the ray
+   enters it. Returns false once the ray has left the grid. */
+bool GridWalk::next (const int** begin, const int** end, float* tcell)
+{
+	if (done)
+		return false;
+
+	int c=cy*grid->cols+cx;
+	*begin=grid->items.data()+grid->start[c];
+	*end=grid->items.data()+grid->start[c+1];
+	*tcell=t;
+
+	if (nextx<nexty)
+	{
+		cx+=stepx;
+		t=nextx;
+		nextx+=deltax;
+	}
+	else
+	{
+		cy+=stepy;
+		t=nexty;
+		nexty+=deltay;
+	}
+	if (cx<0 || cx>=grid->cols || cy<0 || cy>=grid->rows || t>tend)
+		done=true;
+	return true;
+}
@@ -0,0 +1,45 @@
+#ifndef BRICKGRID_H
+#define BRICKGRID_H
+
+#include <vector>
+
+#include "brickpool.h"
+
+/* Uniform grid over the bricks' boxes, so a ray only has to be tested
+   against the bricks in the cells it passes through. Columns are centred
+   on the brick lanes, so a brick never straddles two columns. */
+
+#define GRID_CELL 0.5f
+
+struct BrickGrid {
+	float x0;		// lower left corner of cell (0,0)
+	float y0;
+	int cols;
+	int rows;
+	std::vector<int> start;	// cell c holds items[start[c]] .. items[start[c+1]-1]
+	std::vector<int> items;	// brick slots
+	std::vector<float> itemx;	// brick positions, in the same order as items
+	std::vector<float> itemy;
+	std::vector<int> fill;	// scratch space for build()
+	std::vector<unsigned> hits;	// scratch space for hit masks
+
+	BrickGrid() : x0(0), y0(0), cols(0), rows(0) {}
+	void build(const BrickPool& bricks);
+};
+
+/* Walks the cells of a grid in the order a ray passes through them */
+struct GridWalk {
+	const BrickGrid* grid;
+	int cx, cy;
+	int stepx, stepy;
+	float t;		// time the ray enters the current cell
+	float tend;
+	float nextx, nexty;	// time of the next column / row crossing
+	float deltax, deltay;
+	bool done;
+
+	void init(const BrickGrid& g, float ox, float oy, float dx, float dy, float tmax);
+	bool next(const int** begin, const int** end, float* tcell);
+};
+
+#endif
@@ -0,0 +1,162 @@
+#include <cmath>
+#include <algorithm>
+
+#include "brickpolicy.h"
+
+/* Centre of a brick's box, relative to its origin */
+static const float BRICK_CY=3.6f;
+
+/* Orders slots by height, lowest first */
+struct LowerBrick {
+	const BrickPool* bricks;
+	bool operator() (int a, int b) const { return bricks->y[a]<bricks->y[b]; }
+};
+
+void observe (const BrickWorld& world, struct BrickObservation* obs)
+{
+	obs->cannony=world.cannon.y;
+	obs->cannonangle=world.cannon.cannon_rotation;
+	obs->bucketx[0]=world.buck[0].x;
+	obs->bucketx[1]=world.buck[1].x;
+	obs->laserx=world.laser.x;
+	obs->lasery=world.laser.y;
+	obs->laserangle=world.laser.laser_rotation;
+	obs->laserflying=world.laser.flying;
+	obs->brickspeed=world.brickspeed;
+	obs->score=world.score;
+	obs->lives=world.lives;
+
+	const BrickPool& bricks = world.bricks;
+	int n=bricks.live, j;
+	const int* slots=bricks.livelist.data();
+	int lowest[OBS_MAX_BRICKS];
+	if (n>OBS_MAX_BRICKS)
+	{
+		/* Keep the bricks closest to the buckets */
+		LowerBrick lower={ &bricks };
+		std::partial_sort_copy(slots,slots+n,lowest,lowest+OBS_MAX_BRICKS,lower);
+		slots=lowest;
+		n=OBS_MAX_BRICKS;
+	}
+	obs->nbricks=n;
+	for (j=0;j<n;j++)
+	{
+		int i=slots[j];
+		obs->brickx[j]=bricks.x[i];
+		obs->bricky[j]=bricks.y[i]+BRICK_CY;
+		obs->brickcol[j]=bricks.col[i];
+	}
+}
+
+/* The commands the same key presses would queue */
+void actionInputs (unsigned action, BrickInputs& in)
+{
+	if (action & ACT_CANNON_UP)
+		in.push(CMD_CANNON_UP);
+	if (action & ACT_CANNON_DOWN)
+		in.push(CMD_CANNON_DOWN);
+	if (action & ACT_TURN_UP)
+		in.push(CMD_TURN_UP);
+	if (action & ACT_TURN_DOWN)
+		in.push(CMD_TURN_DOWN);
+	if (action & ACT_RED_LEFT)
+		in.push(CMD_BUCKET_LEFT,0);
+	if (action & ACT_RED_RIGHT)
+		in.push(CMD_BUCKET_RIGHT,0);
+	if (action & ACT_BLUE_LEFT)
+		in.push(CMD_BUCKET_LEFT,1);
+	if (action & ACT_BLUE_RIGHT)
+		in.push(CMD_BUCKET_RIGHT,1);
+	if (action & ACT_FIRE)
+		in.push(CMD_FIRE);
+}
+
+void stepBatch (BrickWorld* worlds, int n, BrickPolicy& policy, struct BrickObservation* obs, unsigned* actions)
+{
+	int i;
+	for (i=0;i<n;i++)
+		observe(worlds[i],&obs[i]);
+	policy.act(obs,actions,n);
+
+	BrickInputs in;
+	for (i=0;i<n;i++)
+	{
+		in.clear();
+		actionInputs(actions[i],in);
+		worlds[i].step(in);
+	}
+}
+
+/* Angle the cannon has to point at to hit a brick now at (x,y), allowing
+   for the brick falling while the shot flies there */
+static float leadAngle (const struct BrickObservation& o, float x, float y)
+{
+	float ty=y;
+	int k;
+	for (k=0;k<3;k++)
+	{
+		float dx=x+3.5f, dy=ty-o.cannony;
+		float steps=(sqrt(dx*dx+dy*dy)-LASER_LENGTH)/LASER_SPEED;
+		ty=y+o.brickspeed*steps;
+	}
+	return atan2(ty-o.cannony,x+3.5f)*180/M_PI;
+}
+
+/* Nudge a bucket towards 'target', one key press per step */
+static unsigned moveBucket (float x, float target, unsigned left, unsigned right)
+{
+	if (target<x-0.05f)
+		return left;
+	if (target>x+0.05f)
+		return right;
+	return 0;
+}
+
+void AimPolicy::act (const struct BrickObservation* obs, unsigned* actions, int n)
+{
+	int i, j;
+	for (i=0;i<n;i++)
+	{
+		const struct BrickObservation& o = obs[i];
+		unsigned a=0;
+
+		/* Lowest brick of each colour still above the buckets */
+		int low[4]={ -1, -1, -1, -1 };
+		for (j=0;j<o.nbricks;j++)
+		{
+			int c=o.brickcol[j];
+			if (low[c]<0 || o.bricky[j]<o.bricky[low[c]])
+				low[c]=j;
+		}
+
+		/* Shoot the lowest black brick, if it is still well above the buckets */
+		int target=low[BRICK_BLACK];
+		if (target>=0 && o.bricky[target]>-2.0f)
+		{
+			float want=leadAngle(o,o.brickx[target],o.bricky[target]);
+			if (want>o.cannonangle+1.5f && o.cannonangle<75)
+				a|=ACT_TURN_UP;
+			else if (want<o.cannonangle-1.5f && o.cannonangle>-75)
+				a|=ACT_TURN_DOWN;
+			else if (!o.laserflying)
+				a|=ACT_FIRE;
+		}
+
+		/* Catch red in the red bucket and blue in the blue one, but get
+		   out from under a black brick that is about to land */
+		static const int want[2]={ BRICK_RED, BRICK_BLUE };
+		static const unsigned left[2]={ ACT_RED_LEFT, ACT_BLUE_LEFT };
+		static const unsigned right[2]={ ACT_RED_RIGHT, ACT_BLUE_RIGHT };
+		int k;
+		for (k=0;k<2;k++)
+		{
+			float x=o.bucketx[k];
+			int black=low[BRICK_BLACK];
+			if (black>=0 && o.bricky[black]<-1.5f && fabs(o.brickx[black]-x)<0.9f)
+				a|=moveBucket(x,o.brickx[black]<x ? 2.5f : -2.5f,left[k],right[k]);
+			else if (low[want[k]]>=0)
+				a|=moveBucket(x,o.brickx[low[want[k]]],left[k],right[k]);
+		}
+		actions[i]=a;
+	}
+}
@@ -0,0 +1,66 @@
+#ifndef BRICKPOLICY_H
+#define BRICKPOLICY_H
+
+#include "brickworld.h"
+
+/* Automated players. A policy sees each world through a small fixed-size
+   observation and answers with an action mask, covering the same inputs
+   a player has on the keyboard. stepBatch() observes a whole batch of
+   worlds, asks the policy once for all of them and steps them, so a
+   policy can work on many worlds at a time. */
+
+#define OBS_MAX_BRICKS 32
+
+/* What a policy sees of a world. Positions are in world coordinates;
+   brick positions are the centres of the bricks' boxes. */
+struct BrickObservation {
+	float cannony;
+	float cannonangle;	// degrees
+	float bucketx[2];	// red bucket, blue bucket
+	float laserx;		// tail of the laser
+	float lasery;
+	float laserangle;
+	int laserflying;
+	float brickspeed;	// per step, negative
+	int score;
+	int lives;
+	int nbricks;		// the lowest ones if more are in play
+	float brickx[OBS_MAX_BRICKS];
+	float bricky[OBS_MAX_BRICKS];
+	unsigned char brickcol[OBS_MAX_BRICKS];
+};
+
+/* Action bits, one step's worth of key presses */
+enum BrickActionBits {
+	ACT_CANNON_UP = 1,		// 'a'
+	ACT_CANNON_DOWN = 2,		// 'd'
+	ACT_TURN_UP = 4,		// 's'
+	ACT_TURN_DOWN = 8,		// 'f'
+	ACT_FIRE = 16,			// space
+	ACT_RED_LEFT = 32,		// alt + left
+	ACT_RED_RIGHT = 64,		// alt + right
+	ACT_BLUE_LEFT = 128,		// ctrl + left
+	ACT_BLUE_RIGHT = 256		// ctrl + right
+};
+
+struct BrickPolicy {
+	virtual ~BrickPolicy() {}
+	/* Fill actions[i] for obs[i], i < n. May be called for several
+	   batches at once from different threads. */
+	virtual void act(const struct BrickObservation* obs, unsigned* actions, int n) = 0;
+};
+
+/* Shoots the lowest black brick it can reach, and keeps each bucket
+   under the lowest brick of its colour and away from black ones */
+struct AimPolicy : BrickPolicy {
+	void act(const struct BrickObservation* obs, unsigned* actions, int n);
+};
+
+void observe(const BrickWorld& world, struct BrickObservation* obs);
+void actionInputs(unsigned action, BrickInputs& in);
+
+/* One step of worlds[0..n-1] under 'policy'. 'obs' and 'actions' are
+   scratch space for n entries each. */
+void stepBatch(BrickWorld* worlds, int n, BrickPolicy& policy, struct BrickObservation* obs, unsigned* actions);
+
+#endif
@@ -0,0 +1,61 @@
+#include "brickpool.h"
+
+/* Drop every brick, keeping the allocated arrays for reuse */
+void BrickPool::clear ()
+{
+	x.clear();
+	y.clear();
+	py.clear();
+	yco.clear();
+	col.clear();
+	state.clear();
+	freelist.clear();
+	livelist.clear();
+	liveindex.clear();
+	live=0;
+}
+
+/* Return a slot for a new brick, recycling a dead one when possible */
+int BrickPool::alloc ()
+{
+	int no;
+	if (!freelist.empty())
+	{
+		no=freelist.back();
+		freelist.pop_back();
+	}
+	else
+	{
+		no=size();
+		x.push_back(0);
+		y.push_back(0);
+		py.push_back(0);
+		yco.push_back(0);
+		col.push_back(0);
+		state.push_back(BRICK_FREE);
+		liveindex.push_back(0);
+	}
+	x[no]=0;
+	y[no]=0;
+	py[no]=0;
+	yco[no]=0;
+	col[no]=0;
+	state[no]=BRICK_LIVE;
+	liveindex[no]=live;
+	livelist.push_back(no);
+	live++;
+	return no;
+}
+
+/* Free a slot. The last live slot moves into its place in livelist. */
+void BrickPool::release (int no)
+{
+	int last=livelist.back();
+	livelist[liveindex[no]]=last;
+	liveindex[last]=liveindex[no];
+	livelist.pop_back();
+
+	state[no]=BRICK_FREE;
+	freelist.push_back(no);
+	live--;
+}
@@ -0,0 +1,38 @@
+#ifndef BRICKPOOL_H
+#define BRICKPOOL_H
+
+#include <vector>
+
+/* Bricks stored as a structure of arrays, so a pass over the bricks only
+   pulls in the fields it reads. Dead slots go on a free list and are
+   handed out again by alloc(), so the arrays only ever grow to the most
+   bricks that were in play at the same time. Live slots are also kept
+   densely in 'livelist', so walking the bricks costs O(live), however
+   many slots the arrays have. */
+
+enum BrickState {
+	BRICK_FREE = 0,
+	BRICK_LIVE = 1
+};
+
+struct BrickPool {
+	std::vector<float> x;		// position of the brick's origin
+	std::vector<float> y;
+	std::vector<float> py;		// y one step earlier, for interpolation
+	std::vector<float> yco;		// steps since spawn
+	std::vector<unsigned char> col;
+	std::vector<unsigned char> state;
+	std::vector<int> freelist;
+	std::vector<int> livelist;	// live slots, in no particular order
+	std::vector<int> liveindex;	// position of each live slot in livelist
+	int live;
+
+	BrickPool() : live(0) {}
+	int size() const { return (int)state.size(); }
+
+	void clear();
+	int alloc();
+	void release(int no);
+};
+
+#endif
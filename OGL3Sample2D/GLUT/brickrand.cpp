@@ -0,0 +1,31 @@
+#include "brickrand.h"
+
+void BrickRandom::seed (unsigned long long seed, unsigned long long stream)
+{
+	state=0;
+	inc=(stream<<1)|1;
+	next();
+	state+=seed;
+	next();
+}
+
+unsigned BrickRandom::next ()
+{
+	unsigned long long old=state;
+	state=old*6364136223846793005ULL+inc;
+	unsigned xorshifted=(unsigned)(((old>>18)^old)>>27);
+	unsigned rot=(unsigned)(old>>59);
+	return (xorshifted>>rot)|(xorshifted<<((-rot)&31));
+}
+
+/* Draws again rather than favour the low values when n doesn't divide 2^32 */
+unsigned BrickRandom::below (unsigned n)
+{
+	unsigned threshold=(0u-n)%n;
+	while (1)
+	{
+		unsigned r=next();
+		if (r>=threshold)
+			return r%n;
+	}
+}
@@ -0,0 +1,17 @@
+#ifndef BRICKRAND_H
+#define BRICKRAND_H
+
+/* PCG32 random numbers (O'Neill, pcg-random.org). Each world owns one,
+   so a game seeded the same way plays out the same way, and nothing is
+   shared with other worlds or with libc's rand(). */
+
+struct BrickRandom {
+	unsigned long long state;
+	unsigned long long inc;		// stream, always odd
+
+	void seed(unsigned long long seed, unsigned long long stream=0);
+	unsigned next();
+	unsigned below(unsigned n);	// uniform in [0, n)
+};
+
+#endif
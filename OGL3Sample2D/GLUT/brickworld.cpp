@@ -0,0 +1,264 @@
+#include <cmath>
+
+#include "brickworld.h"
+#include "profile.h"
+
+void BrickInputs::push (int type, int bucket, float x, float y)
+{
+	if (count==MAX_COMMANDS)
+		return;
+	cmd[count].type=type;
+	cmd[count].bucket=bucket;
+	cmd[count].x=x;
+	cmd[count].y=y;
+	count++;
+}
+
+/* Reset the world to the state of a freshly started game. Games started
+   with the same seed and fed the same commands play out the same way. */
+void BrickWorld::init (unsigned long long seed)
+{
+	bricks.clear();
+	spawntimer=0;
+	spawninterval=BRICK_SPAWN_INTERVAL;
+	rng.seed(seed);
+	buck[0].x=1.2f;
+	buck[1].x=-1.2f;
+	cannon.x=-3.6f;
+	cannon.y=0.0f;
+	cannon.cannon_rotation=0;
+	resetLaser();
+	brickspeed=-0.01f;
+	score=0;
+	lives=5;
+	gameover=0;
+	ticks=0;
+	events=0;
+	spawned=-1;
+}
+
+/* Apply one player command */
+void BrickWorld::apply (const BrickCommand& c)
+{
+	if (c.type==CMD_FASTER)
+	{
+		if (brickspeed>-0.04f)
+		{
+			brickspeed=brickspeed-0.01f;
+			laser.stale=1;
+		}
+	}
+	if (c.type==CMD_SLOWER)
+	{
+		if (brickspeed<-0.01f)
+		{
+			brickspeed=brickspeed+0.01f;
+			laser.stale=1;
+		}
+	}
+	if (c.type==CMD_CANNON_UP)
+	{
+		if (cannon.y<3.5)
+			cannon.y+=0.1f;
+	}
+	if (c.type==CMD_CANNON_DOWN)
+	{
+		if (cannon.y>-2.0)
+			cannon.y-=0.1f;
+	}
+	if (c.type==CMD_TURN_UP)
+	{
+		if (cannon.cannon_rotation<75)
+			cannon.cannon_rotation=((int)cannon.cannon_rotation%90+3)%90;
+	}
+	if (c.type==CMD_TURN_DOWN)
+	{
+		if (cannon.cannon_rotation>-75)
+			cannon.cannon_rotation=(((int)cannon.cannon_rotation%90-3)%90);
+	}
+	if (c.type==CMD_BUCKET_LEFT)
+	{
+		if (buck[c.bucket].x>-2.5)
+			buck[c.bucket].x-=0.1f;
+	}
+	if (c.type==CMD_BUCKET_RIGHT)
+	{
+		if (buck[c.bucket].x<2.5)
+			buck[c.bucket].x+=0.1f;
+	}
+	if (c.type==CMD_AIM)
+	{
+		cannon.cannon_rotation=0;
+		float angle=atan2(c.y-cannon.y,c.x+3.2) * 180 / M_PI;
+		if (angle<75 && angle>-75)
+			cannon.cannon_rotation=angle;
+	}
+	if (c.type==CMD_DRAG)
+	{
+		if (c.x<-3 && c.x>-3.5 && c.y>-0.3+cannon.y && c.y<0.3+cannon.y)
+		{
+			if (c.y<3.5 && c.y>-2)
+			{
+				cannon.x=-3.6f;
+				cannon.y=c.y;
+			}
+		}
+		else if (c.y>-4 && c.y<-3 && c.x>buck[0].x-0.8 && c.x<buck[0].x+0.8)
+		{
+			if (c.x>-2.5 && c.x<2.5)
+				buck[0].x=c.x;
+		}
+		else if (c.y>-4 && c.y<-3 && c.x>buck[1].x-0.8 && c.x<buck[1].x+0.8)
+		{
+			if (c.x>-2.5 && c.x<2.5)
+				buck[1].x=c.x;
+		}
+	}
+	if (c.type==CMD_FIRE)
+	{
+		if (!laserFlying())
+		{
+			fireLaser();
+			events|=EV_FIRE;
+		}
+	}
+}
+
+/* Advance the game by one step */
+void BrickWorld::step (const BrickInputs& in)
+{
+	events=0;
+	spawned=-1;
+	if (gameover)
+		return;
+	ticks++;
+
+	int i;
+	for (i=0;i<in.count;i++)
+	{
+		apply(in.cmd[i]);
+		/* An idle laser sits in the cannon and follows it */
+		if (!laserFlying())
+			resetLaser();
+	}
+
+	/* The shot moves and hits bricks before the bricks move */
+	if (laserFlying())
+	{
+		ProfileScope prof(PROF_COLLIDE);
+		advanceLaser();
+	}
+
+	/* Walk backwards, so a brick released mid-walk is replaced by one
+	   that has already been updated */
+	{
+		ProfileScope prof(PROF_MOVE);
+		for (i=bricks.live-1;i>=0 && !gameover;i--)
+			updateBrick(bricks.livelist[i]);
+	}
+
+	if (!gameover && spawntimer==0)
+	{
+		ProfileScope prof(PROF_SPAWN);
+		spawnBrick();
+		spawntimer=spawninterval;
+	}
+	spawntimer--;
+
+	/* Out of range, back into the cannon */
+	if (!laserFlying())
+		resetLaser();
+}
+
+void BrickWorld::spawnBrick ()
+{
+	int no=bricks.alloc();
+
+	bricks.col[no]=rng.below(4);
+
+	/* Lanes -4..3, with -4 picked twice as often */
+	int y=rng.below(9);
+	int xco=(y==8) ? -4 : y-4;
+	bricks.x[no]=0.5f*xco;
+	bricks.y[no]=0;
+	bricks.yco[no]=1;
+
+	spawned=no;
+	events|=EV_SPAWN;
+	laser.stale=1;
+}
+
+/* Collect and move one brick. Uses last step's brick position.
+   The slot is released as soon as the brick leaves play. */
+void BrickWorld::updateBrick (int no)
+{
+	int out=0;
+	float bx=bricks.x[no];
+	float by=bricks.y[no];
+	int col=bricks.col[no];
+
+	/* Brick reached the buckets */
+	if (by<-6.5)
+	{
+		out=1;
+		int k;
+		for (k=0;k<2;k++)
+		{
+			if (bx>buck[k].x-0.8 && bx<buck[k].x+0.8)
+			{
+				if (col==BRICK_BLACK)
+				{
+					gameover=1;
+					return;
+				}
+				/* Red bucket is buck[0], blue bucket is buck[1] */
+				if ((col==BRICK_RED && k==0) || (col==BRICK_BLUE && k==1))
+				{
+					score+=10;
+					events|=EV_SCORE;
+					break;
+				}
+			}
+		}
+	}
+
+	if (out)
+	{
+		bricks.release(no);
+		laser.stale=1;
+		return;
+	}
+	bricks.py[no]=by;
+	bricks.y[no]=brickspeed*bricks.yco[no];
+	bricks.yco[no]++;
+}
+
+/* Score a laser hit on a brick of colour 'col'. Returns 1 if the brick
+   is destroyed. */
+int BrickWorld::laserHit (int col)
+{
+	if (col==BRICK_GREEN)
+	{
+		/* Green bricks deflect the laser and stay in play */
+		score+=50;
+		events|=EV_SCORE;
+		return 0;
+	}
+
+	if (col==BRICK_BLACK)
+	{
+		score+=10;
+		events|=EV_BRICK_HIT;
+	}
+	else
+	{
+		/* Misfire at a red or blue brick */
+		if (score>0)
+			score-=10;
+		lives--;
+		if (lives==0)
+			gameover=1;
+	}
+	events|=EV_SCORE;
+	return 1;
+}
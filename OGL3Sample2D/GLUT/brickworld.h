@@ -0,0 +1,150 @@
+#ifndef BRICKWORLD_H
+#define BRICKWORLD_H
+
+#include "brickpool.h"
+#include "brickgrid.h"
+#include "brickrand.h"
+
+/* Game rules for the brick breaker, kept free of any GL or GLUT calls.
+   The frontend queues player commands into BrickInputs, calls step()
+   BRICK_TICK_RATE times a second and renders whatever state the world is
+   left in. All speeds and intervals below are per step. */
+
+#define BRICK_TICK_RATE 60		// steps per second
+#define BRICK_SPAWN_INTERVAL 50	// default steps between two bricks
+
+/* Brick colours, as used by the scoring rules */
+enum BrickColor {
+	BRICK_RED = 0,
+	BRICK_BLACK = 1,
+	BRICK_BLUE = 2,
+	BRICK_GREEN = 3
+};
+
+/* Commands a player can issue, one per key press / mouse event */
+enum BrickCommandType {
+	CMD_CANNON_UP,		// 'a'
+	CMD_CANNON_DOWN,	// 'd'
+	CMD_TURN_UP,		// 's'
+	CMD_TURN_DOWN,		// 'f'
+	CMD_FASTER,		// 'n'
+	CMD_SLOWER,		// 'm'
+	CMD_BUCKET_LEFT,	// alt/ctrl + left, bucket = 0/1
+	CMD_BUCKET_RIGHT,	// alt/ctrl + right, bucket = 0/1
+	CMD_AIM,		// left click at world (x, y)
+	CMD_DRAG,		// mouse drag to world (x, y)
+	CMD_FIRE		// space
+};
+
+struct BrickCommand {
+	int type;
+	int bucket;
+	float x;
+	float y;
+};
+
+#define MAX_COMMANDS 64
+
+/* Commands collected between two steps */
+struct BrickInputs {
+	int count;
+	struct BrickCommand cmd[MAX_COMMANDS];
+
+	BrickInputs() : count(0) {}
+	void clear() { count = 0; }
+	void push(int type, int bucket=0, float x=0, float y=0);
+};
+
+/* Things that happened during the last step, for the frontend to react to */
+enum BrickEvent {
+	EV_SCORE = 1,		// score or lives changed
+	EV_BRICK_HIT = 2,	// laser destroyed a black brick
+	EV_SPAWN = 4,		// a new brick was spawned in pool slot 'spawned'
+	EV_FIRE = 8		// a shot left the cannon
+};
+
+struct WorldBucket {
+	float x;
+};
+
+struct WorldCannon {
+	float x;
+	float y;
+	float cannon_rotation;
+};
+
+#define LASER_SPEED 0.1f	// units the shot moves per step
+#define LASER_LENGTH 0.6f
+#define LASER_RANGE 10.0f	// units a shot travels; the side mirror restarts it
+#define MAX_LASER_NODES 32
+
+/* What the tip of the shot runs into at a path node */
+enum LaserNodeKind {
+	NODE_START,
+	NODE_SIDE_MIRROR,	// upright mirror on the right
+	NODE_MIRROR,		// diagonal mirror in the middle
+	NODE_GREEN,		// green brick, deflects the shot
+	NODE_BRICK,		// any other brick, ends the shot
+	NODE_END		// out of range
+};
+
+struct LaserNode {
+	float t;	// steps since the shot was fired
+	float x;	// position of the tip
+	float y;
+	float angle;	// direction from here on, in degrees
+	float range;	// distance left from here on
+	int kind;
+	int no;		// brick slot for NODE_GREEN and NODE_BRICK
+};
+
+/* A shot follows a path traced ahead of time: straight segments between
+   the nodes where its tip meets a mirror or a brick. */
+struct WorldLaser {
+	float x;	// tail of the laser
+	float y;
+	float laser_rotation;
+	int flying;
+	float t;	// steps since the shot was fired
+	int node;	// last path node the tip has passed
+	int nnodes;
+	int stale;	// bricks changed since the path was traced
+	struct LaserNode path[MAX_LASER_NODES];
+};
+
+struct BrickWorld {
+	struct BrickPool bricks;
+	struct BrickGrid grid;		// bricks by position, rebuilt for each trace
+	int spawntimer;		// steps until the next brick
+	int spawninterval;	// steps between two bricks
+	struct BrickRandom rng;	// colours and lanes of new bricks
+	struct WorldBucket buck[2];
+	struct WorldCannon cannon;
+	struct WorldLaser laser;
+	float brickspeed;
+	int score;
+	int lives;
+	int gameover;
+	unsigned ticks;		// steps since init()
+
+	int events;		// BrickEvent mask from the last step
+	int spawned;		// slot spawned during the last step, or -1
+
+	void init(unsigned long long seed);
+	void step(const BrickInputs& in);
+	bool laserFlying() const;
+	int traceLaser(float x, float y, float angle, float t0, float range, struct LaserNode* path);
+
+private:
+	void fireLaser();
+	void retraceLaser();
+	void advanceLaser();
+	void placeLaser();
+	void resetLaser();
+	void apply(const BrickCommand& c);
+	void spawnBrick();
+	void updateBrick(int no);
+	int laserHit(int col);
+};
+
+#endif
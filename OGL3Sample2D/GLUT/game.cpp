@@ -0,0 +1,658 @@
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <math.h>
+
+#include "game.h"
+#include "glstate.h"
+#include "programcache.h"
+#include "audio.h"
+#include "profile.h"
+#include "inputlog.h"
+#include "offscreen.h"
+#include "brickpolicy.h"
+
+using namespace std;
+
+int width = 600;
+int height = 600;
+
+struct GLbucket {
+	struct VAO* bucketimg;
+	struct Transform transform;
+};
+
+struct GLcannon {
+	struct VAO* cannonimg;
+	struct Transform transform;
+};
+
+struct GLlaser {
+	struct VAO* laserimg;
+	struct Transform transform;
+};
+
+/* Game state lives in 'world'; everything below is only used to draw it */
+BrickWorld world;
+BrickInputs pending;
+struct VAO* brickmesh;
+struct GLbucket buck[2];
+struct GLcannon cannon;
+struct GLlaser laser;
+struct VAO* scenery;	// the mirrors and the left wall, in world space
+float zoom;
+
+/* The camera never moves, so the view-projection matrix only changes
+   with the projection, which is always set through setProjection().
+   'vpversion' counts the times it has, for the objects' transforms. */
+glm::mat4 VP;
+bool vpstale = true;
+unsigned vpversion;
+
+void setProjection (float left, float right, float bottom, float top)
+{
+	Matrices.projection = glm::ortho(left, right, bottom, top, 0.1f, 500.0f);
+	vpstale = true;
+}
+
+/* The world steps at a fixed BRICK_TICK_RATE, whatever the frame rate.
+   Frames are drawn 'tick_alpha' of the way from the previous step to the
+   current one. */
+typedef std::chrono::steady_clock Clock;
+const Clock::duration tick_length = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0/BRICK_TICK_RATE));
+const int max_ticks_per_frame = 8;
+Clock::time_point nexttick;
+float tick_alpha = 1;
+struct WorldLaser prevlaser;
+unsigned long long seed;	// for the world's random numbers, from --seed or the clock
+InputLog inputlog;		// open when the game is being recorded
+bool offscreen = false;		// drawing into an FBO, with no window
+BrickPolicy* autoplayer = NULL;	// plays instead of the keyboard if set
+
+const char* datadir = "";
+void (*swapBuffers)() = NULL;
+
+/* Set by gameOptions() */
+static const char* sink = "alsa";
+static const char* record = NULL;
+static const char* dump = NULL;
+static struct InputReplay replay;
+static int frames = 0;
+static bool orphan = false;		// --orphan: no persistent mapping
+static const char* shadercache = "";	// --shader-cache=FILE; "" for the default, NULL for none
+
+/* Sound effects, mixed on the audio thread */
+AudioMixer audio;
+int cannonsound = -1;
+int bricksound = -1;
+
+GLuint programID;
+
+/* Path of one of the game's files */
+static string dataPath (const char* name)
+{
+	return string(datadir) + name;
+}
+
+/**************************
+ * Customizable functions *
+ **************************/
+
+/* Executed when a regular key is pressed */
+void keyCommand (unsigned char key)
+{
+	ProfileScope prof(PROF_INPUT);
+	if (key=='n')
+		pending.push(CMD_FASTER);
+	if (key=='m')
+		pending.push(CMD_SLOWER);
+	if (key=='a')
+		pending.push(CMD_CANNON_UP);
+	if (key=='d')
+		pending.push(CMD_CANNON_DOWN);
+	if (key=='s')
+		pending.push(CMD_TURN_UP);
+	if (key=='f')
+		pending.push(CMD_TURN_DOWN);
+	if (key==32)
+		pending.push(CMD_FIRE);
+}
+
+/* Executed when an arrow key is pressed */
+float pan;
+void arrowKey (int arrow, int mods)
+{
+	if (arrow==ARROW_UP)
+		zoomIn();
+	if (arrow==ARROW_DOWN)
+		zoomOut();
+	if (arrow==ARROW_RIGHT)
+	{
+			if (zoom>0.1 && pan>-zoom+0.1)
+				pan=pan-0.4;
+			setProjection(-4.0f+zoom-pan, 4.0f-zoom-pan, -4.0f+zoom, 4.0f-zoom);
+	}
+	if (arrow==ARROW_LEFT)
+	{
+		if (zoom<1.5 && pan<zoom)
+			pan=pan+0.4;
+		setProjection(-4.0f+zoom-pan, 4.0f-zoom-pan, -4.0f+zoom, 4.0f-zoom);
+	}
+	if (arrow==ARROW_LEFT && mods==KEYMOD_ALT)
+		pending.push(CMD_BUCKET_LEFT, 0);
+	if (arrow==ARROW_RIGHT && mods==KEYMOD_ALT)
+		pending.push(CMD_BUCKET_RIGHT, 0);
+	if (arrow==ARROW_LEFT && mods==KEYMOD_CTRL)
+		pending.push(CMD_BUCKET_LEFT, 1);
+	if (arrow==ARROW_RIGHT && mods==KEYMOD_CTRL)
+		pending.push(CMD_BUCKET_RIGHT, 1);
+}
+
+/* Executed for the up arrow or the mouse wheel */
+void zoomIn ()
+{
+	if (zoom<1.5)
+		zoom=zoom+0.4;
+	setProjection(-4.0f+zoom, 4.0f-zoom, -4.0f+zoom, 4.0f-zoom);
+}
+
+void zoomOut ()
+{
+	if (zoom>0.1)
+		zoom=zoom-0.4;
+	setProjection(-4.0f+zoom, 4.0f-zoom, -4.0f+zoom, 4.0f-zoom);
+}
+
+/* Executed when the left mouse button goes down at ('x', 'y') */
+void aimAt (int x, int y)
+{
+	float mouseX = -1.0 + 2.0 * x / 600 ;
+	float mouseY = 1.0 - 2.0 * y / 600;
+	pending.push(CMD_AIM, 0, 4*mouseX, 4*mouseY);
+}
+
+/* Executed when the mouse moves to position ('x', 'y') with a button down */
+void dragTo (int x, int y)
+{
+	float mouseX = 4*(-1.0 + 2.0 * x / 600);
+	float mouseY = 4*(1.0 - 2.0 * y / 600);
+	pending.push(CMD_DRAG, 0, mouseX, mouseY);
+}
+
+/* Executed when window is resized to 'width' and 'height' */
+/* Modify the bounds of the screen here in glm::ortho */
+void reshapeWindow (int width, int height)
+{
+	// sets the viewport of openGL renderer
+	glViewport (0, 0, (GLsizei) width, (GLsizei) height);
+
+	// set the projection matrix as ortho
+	// Store the projection matrix in a variable for future use
+
+    // Ortho projection for 2D views
+    setProjection(-4.0f, 4.0f, -4.0f, 4.0f);
+}
+
+/* The left wall and the two mirrors never move, so they are put into
+   world space once, as one mesh drawn in a single call */
+void createScenery ()
+{
+  // GL3 accepts only Triangles; a quad is two, indexed so they share two corners
+  static const GLfloat rectangle_corners [] = {
+    -0.2,-2.5, // vertex 1
+    0.6,-2.5, // vertex 2
+    0.6, 4, // vertex 3
+    -0.2, 4, // vertex 4
+  };
+  static const GLfloat mirror_corners [] = {
+    -0.05,0, // vertex 1
+    0.05,0, // vertex 2
+    0.05, 1, // vertex 3
+    -0.05, 1, // vertex 4
+  };
+
+  struct MeshBatch batch;
+  glm::mat4 translatemirror1 = glm::translate (glm::vec3(0.0f, 1.0f, 0.0f));
+  glm::mat4 rotatemirror1 = glm::rotate((float)(45*M_PI/180.0f), glm::vec3(0,0,1));  // rotate about vector (0,0,1)
+  batchQuad(&batch, mirror_corners, 0.44,0.65,1, translatemirror1*rotatemirror1);
+  batchQuad(&batch, rectangle_corners, 0,0,0, glm::translate (glm::vec3(-4.0f, 0.0f, 0.0f)));
+  batchQuad(&batch, mirror_corners, 0.44,0.65,1, glm::translate (glm::vec3(3.05f, 0.0f, 0.0f)));
+
+  // createBatch creates and returns a handle to a VAO that can be used later
+  scenery = createBatch(&batch, GL_FILL);
+}
+
+void createCannon ()
+{
+  // GL3 accepts only Triangles; a quad is two, indexed so they share two corners
+  static const GLfloat corners [] = {
+    -0.3,-0.3, // vertex 1
+    0.3,-0.3, // vertex 2
+    0.3, 0.3, // vertex 3
+    -0.3, 0.3, // vertex 4
+  };
+
+  // createQuad creates and returns a handle to a VAO that can be used later
+  cannon.cannonimg = createQuad(corners, 1,0,1, GL_FILL);
+}
+void createLaser ()
+{
+  // GL3 accepts only Triangles; a quad is two, indexed so they share two corners
+  static const GLfloat corners [] = {
+    0.0,-0.1, // vertex 1
+    0.6,-0.1, // vertex 2
+    0.6, 0.1, // vertex 3
+    0.0, 0.1, // vertex 4
+  };
+
+  // createQuad creates and returns a handle to a VAO that can be used later
+  laser.laserimg = createQuad(corners, 1,1,0, GL_FILL);
+}
+
+/* Colours of the four brick kinds, indexed by BrickColor */
+const PackedColor brick_colors[4] = {
+  { 255, 0, 0, 255 },	// red
+  { 0, 0, 0, 255 },	// black
+  { 0, 0, 255, 255 },	// blue
+  { 0, 255, 0, 255 }	// green
+};
+
+/* One quad shared by every brick; position and colour come per instance */
+struct VAO* createBrick()
+{
+  static const GLfloat corners [] = {
+    -0.1,3.5, // vertex 1
+    0.1,3.5, // vertex 2
+    0.1, 3.7, // vertex 3
+    -0.1, 3.7, // vertex 4
+  };
+
+  // createQuad creates and returns a handle to a VAO that can be used later
+  struct VAO* vao = createQuad(corners, 1, 1, 1, GL_FILL);
+  makeInstanced(vao);
+  return vao;
+}
+
+void createBucket1()
+{
+  // GL3 accepts only Triangles; a quad is two, indexed so they share two corners
+  static const GLfloat corners [] = {
+    -0.4,-4, // vertex 1
+    0.4,-4, // vertex 2
+    0.8, -3, // vertex 3
+    -0.8, -3, // vertex 4
+  };
+
+  // createQuad creates and returns a handle to a VAO that can be used later
+  buck[0].bucketimg = createQuad(corners, 1,0,0, GL_FILL);
+}
+
+void createBucket2()
+{
+  // GL3 accepts only Triangles; a quad is two, indexed so they share two corners
+  static const GLfloat corners [] = {
+    -0.4,-4, // vertex 1
+    0.4,-4, // vertex 2
+    0.8, -3, // vertex 3
+    -0.8, -3, // vertex 4
+  };
+
+  // createQuad creates and returns a handle to a VAO that can be used later
+  buck[1].bucketimg = createQuad(corners, 0,0,1, GL_FILL);
+}
+
+
+/* Render the scene with openGL */
+/* Edit this function according to your assignment */
+void draw ()
+{
+  ProfileScope frameprof(PROF_FRAME);
+  gpuTimerBegin();
+  long long t0 = profileEnabled() ? profileNow() : 0;
+
+  // clear the color and depth in the frame buffer
+  glClear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+  // use the loaded shader program
+  // Don't change unless you know what you are doing
+  stateUseProgram (programID);
+
+  // The view only changes with the projection (zoom, pan, reshape), so
+  // ViewProject is recomputed only then
+  if (vpstale)
+  {
+    VP = Matrices.projection * Matrices.view;
+    vpstale = false;
+    vpversion++;
+  }
+
+  // Send our transformation to the currently bound shader, in the "MVP" uniform
+  // For each model you render, since the MVP will be different (at least the M part)
+  //  Don't change unless you are sure!!
+  glm::mat4 MVP;	// MVP = Projection * View * Model
+
+
+  /* Render your scene */
+
+  // The scenery is already in world space, so its model matrix is identity
+  MVP = VP;
+  glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
+  draw3DObject(scenery);
+
+  // The rest keep their matrices from frame to frame, rebuilt only when
+  // they or the camera move
+  setTransform(&buck[0].transform, world.buck[0].x, 0, 0);
+  MVP = transformMVP(&buck[0].transform, VP, vpversion);
+  glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
+  draw3DObject(buck[0].bucketimg);
+
+  setTransform(&buck[1].transform, world.buck[1].x, 0, 0);
+  MVP = transformMVP(&buck[1].transform, VP, vpversion);
+  glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
+  draw3DObject(buck[1].bucketimg);
+
+  float laserx = prevlaser.x + (world.laser.x-prevlaser.x)*tick_alpha;
+  float lasery = prevlaser.y + (world.laser.y-prevlaser.y)*tick_alpha;
+  setTransform(&laser.transform, laserx, lasery, world.laser.laser_rotation);
+  MVP = transformMVP(&laser.transform, VP, vpversion);
+  glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
+
+  // draw3DObject draws the VAO given to it using current MVP matrix
+  draw3DObject(laser.laserimg);
+
+  setTransform(&cannon.transform, world.cannon.x, world.cannon.y, world.cannon.cannon_rotation);
+  MVP = transformMVP(&cannon.transform, VP, vpversion);
+  glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
+
+  // draw3DObject draws the VAO given to it using current MVP matrix
+  draw3DObject(cannon.cannonimg);
+
+  if (profileEnabled())
+  {
+    long long t1 = profileNow();
+    profileRecord(PROF_SCENE, t1-t0);
+    t0 = t1;
+  }
+
+  // All bricks in one instanced draw, positioned by their instance offset
+  // and written straight into the frame's stream buffer
+  struct Instance* brickinstances = mapInstances(world.bricks.live);
+  int j;
+  for (j=0;j<world.bricks.live;j++)
+  {
+	  int i=world.bricks.livelist[j];
+	  brickinstances[j].x=world.bricks.x[i];
+	  brickinstances[j].y=world.bricks.py[i] + (world.bricks.y[i]-world.bricks.py[i])*tick_alpha;
+	  memcpy(brickinstances[j].color, brick_colors[world.bricks.col[i]], sizeof(brickinstances[j].color));
+  }
+  MVP = VP;
+  glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
+  if (profileEnabled())
+    profileRecord(PROF_UPLOAD, profileNow()-t0);
+  {
+    ProfileScope prof(PROF_SUBMIT);
+    draw3DObjectInstanced(brickmesh, world.bricks.live);
+  }
+  //glScalef(0.5f, 0.5f, 2.0f);
+
+  renderFrameEnd();
+  gpuTimerEnd();
+
+  // Swap the frame buffers
+  {
+    ProfileScope prof(PROF_SWAP);
+    if (offscreen)
+      glFlush ();
+    else
+      swapBuffers ();
+  }
+  profileFrame();
+}
+
+/* Run one step of the game with the commands queued since the last one */
+void advance ()
+{
+	prevlaser=world.laser;
+	if (autoplayer)
+	{
+		struct BrickObservation obs;
+		unsigned action;
+		observe(world, &obs);
+		autoplayer->act(&obs, &action, 1);
+		actionInputs(action, pending);
+	}
+	if (inputlog.f)
+		inputlog.write(world.ticks, pending);
+	{
+		ProfileScope prof(PROF_STEP);
+		world.step(pending);
+	}
+	pending.clear();
+
+	// Don't draw the laser sliding across the screen when it jumps back to the cannon
+	if (fabs(world.laser.x-prevlaser.x)+fabs(world.laser.y-prevlaser.y) > 0.5)
+		prevlaser=world.laser;
+
+	if (world.events & EV_FIRE)
+		audio.play(cannonsound);
+	if (world.events & EV_BRICK_HIT)
+		audio.play(bricksound);
+	if (world.events & EV_SCORE)
+		cout << "\r" << "Score: " <<world.score << " " << "Lives: " <<world.lives << flush;
+	if (world.gameover)
+	{
+		cout << "\nGame over\n";
+		// runOffscreen() stops on its own, and still reports the frames
+		if (!offscreen)
+			exit(1);
+	}
+	nexttick+=tick_length;
+}
+
+/* Executed when the program is idle (no I/O activity) */
+void idle () {
+    // Run every step that is due, then draw in between the last two
+    Clock::time_point now = Clock::now();
+    int ticks = 0;
+    while (now >= nexttick && ticks < max_ticks_per_frame)
+    {
+        advance ();
+        ticks++;
+    }
+    if (now >= nexttick)
+        nexttick = now + tick_length; // too far behind, drop the backlog
+
+    tick_alpha = 1 - std::chrono::duration<float>(nexttick - now) / tick_length;
+    if (tick_alpha < 0)
+        tick_alpha = 0;
+    draw ();
+}
+
+
+/* Initialize the OpenGL rendering properties */
+/* Add all the models to be created here */
+void initGL (int width, int height)
+{
+	// Create and compile our GLSL program from the shaders, or take it
+	// from the program cache if an earlier run left it there
+	if (shadercache)
+		programcache = *shadercache ? string(shadercache) : dataPath("Sample_GL.cache");
+	programID = LoadShaders( dataPath("Sample_GL.vert").c_str(), dataPath("Sample_GL.frag").c_str() );
+	// Get a handle for our "MVP" uniform
+	Matrices.MatrixID = glGetUniformLocation(programID, "MVP");
+
+	initStreaming (!orphan);
+	// Fixed camera for 2D (ortho) in XY plane
+	Matrices.view = glm::lookAt(glm::vec3(0,0,3), glm::vec3(0,0,0), glm::vec3(0,1,0));
+	reshapeWindow (width, height);
+
+	// Background color of the scene
+	glClearColor (0.79f, 0.79f, 0.79f, 1.0f); // R, G, B, A
+	glClearDepth (1.0f);
+
+	glEnable (GL_DEPTH_TEST);
+	glDepthFunc (GL_LEQUAL);
+
+	// Create the models
+	createScenery ();
+	createBucket1();
+	createBucket2();
+	createLaser();
+	createCannon();
+	brickmesh = getMesh("brick", createBrick);
+	world.init(seed);
+	prevlaser=world.laser;
+	nexttick=Clock::now();
+	//createLeftSpace()
+
+	cout << "VENDOR: " << glGetString(GL_VENDOR) << endl;
+	cout << "RENDERER: " << glGetString(GL_RENDERER) << endl;
+	cout << "VERSION: " << glGetString(GL_VERSION) << endl;
+	cout << "GLSL: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << endl;
+	cout << "Seed: " << seed << endl;
+	cout << "\r" << "Score: " <<world.score << " " << "Lives: " <<world.lives << flush;  
+}
+
+/* Load the sound effects and start the mixer. 'sink' is "alsa", "null",
+   or the name of a .wav file to record the mix into. */
+void initAudio (const char* sink)
+{
+	AudioSink* s = NULL;
+	if (strcmp(sink, "alsa") == 0)
+	{
+		s = openAlsaSink();
+		if (!s)
+			cerr << "No sound device, playing silently" << endl;
+	}
+	else if (strcmp(sink, "null") != 0)
+	{
+		s = openFileSink(sink);
+		if (!s)
+			cerr << "Can't write " << sink << ", playing silently" << endl;
+	}
+	if (!s)
+		s = openNullSink();
+
+	cannonsound = audio.load(dataPath("cannon.wav").c_str());
+	bricksound = audio.load(dataPath("brick.wav").c_str());
+	audio.start(s);
+}
+
+/* Draw 'frames' frames with no window, one step per frame, as fast as
+   they come, or until the game is over. Commands are taken from 'replay'
+   if it is open, and each frame is saved as <dump>NNNNN.ppm if 'dump' is
+   set. */
+void runOffscreen (int frames, const char* dump, struct InputReplay& replay)
+{
+	Clock::time_point start = Clock::now();
+	unsigned long long issued = 0, elided = 0;
+	int i;
+	for (i=0; i<frames && !world.gameover; i++)
+	{
+		if (replay.f)
+		{
+			replay.read(world.ticks, pending);
+			if (replay.corrupt)
+			{
+				cerr << "\nDamaged recording, a bad command at step " << replay.end << "; replay stopped" << endl;
+				replay.close();
+			}
+		}
+		advance();
+		tick_alpha = 1;
+		draw();
+		issued += glcallslast.issued;
+		elided += glcallslast.elided;
+		if (dump)
+		{
+			char path[1024];
+			snprintf(path, sizeof(path), "%s%05d.ppm", dump, i);
+			if (!dumpFrame(path))
+			{
+				cerr << "Can't write " << path << endl;
+				dump = NULL;
+			}
+		}
+	}
+	glFinish();
+	frames = i;
+	double secs = std::chrono::duration<double>(Clock::now() - start).count();
+	cout << "\n" << frames << " frames in " << secs << " s, " << frames/secs << " fps" << endl;
+	if (frames > 0)
+		cout << "GL state calls per frame: " << (double)issued/frames << " issued, " << (double)elided/frames << " elided" << endl;
+}
+
+
+/* Finish the recording, however the game ends */
+void closeRecording ()
+{
+	if (inputlog.f)
+		inputlog.close(world.ticks);
+}
+
+
+/* Read the command line, then start the sound and the recording */
+void gameOptions (int argc, char** argv)
+{
+	int i;
+	seed = time(NULL);
+	for (i=1; i<argc; i++)
+	{
+		if (strncmp(argv[i], "--audio=", 8) == 0)
+			sink = argv[i]+8;
+		if (strncmp(argv[i], "--record=", 9) == 0)
+			record = argv[i]+9;
+		if (strncmp(argv[i], "--offscreen=", 12) == 0)
+		{
+			offscreen = true;
+			frames = atoi(argv[i]+12);
+		}
+		if (strncmp(argv[i], "--dump=", 7) == 0)
+			dump = argv[i]+7;
+		if (strncmp(argv[i], "--replay=", 9) == 0 && !replay.open(argv[i]+9))
+			cerr << argv[i]+9 << " is not a recording" << endl;
+		if (strcmp(argv[i], "--orphan") == 0)
+			orphan = true;
+		if (strncmp(argv[i], "--shader-cache=", 15) == 0)
+			shadercache = argv[i]+15;
+		if (strcmp(argv[i], "--no-shader-cache") == 0)
+			shadercache = NULL;
+		if (strcmp(argv[i], "--no-state-cache") == 0)
+			statecache = false;
+		if (strcmp(argv[i], "--autoplay") == 0)
+			autoplayer = new AimPolicy;
+		if (strncmp(argv[i], "--seed=", 7) == 0)
+			seed = strtoull(argv[i]+7, NULL, 10);
+		if (strcmp(argv[i], "--profile") == 0)
+			profileStart(NULL);
+		if (strncmp(argv[i], "--profile=", 10) == 0)
+			profileStart(argv[i]+10);
+	}
+	if (replay.f)
+		seed = replay.seed;
+	initAudio(sink);
+	if (record)
+	{
+		if (inputlog.open(record, seed))
+			atexit(closeRecording);
+		else
+			cerr << "Can't write " << record << ", not recording" << endl;
+	}
+}
+
+/* The whole game under --offscreen, with no window */
+int runOffscreenGame ()
+{
+	if (!initOffscreenContext() || !loadGL(offscreenProcAddress))
+		return 1;
+	initOffscreenFramebuffer (width, height);
+	initGL (width, height);
+	runOffscreen (frames, dump, replay);
+	closeOffscreen ();
+	return 0;
+}
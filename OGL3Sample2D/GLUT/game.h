@@ -0,0 +1,42 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include "renderer.h"
+#include "brickworld.h"
+
+/* The game as the GLUT and GLFW frontends both run it: the world, the
+   scene drawn from it, the options and the commands the keyboard and
+   mouse give. A frontend opens the window, loads GL with loadGL() and
+   turns its events into the calls below.
+
+   main() calls gameOptions() first; if that leaves 'offscreen' set it
+   just returns runOffscreenGame(). Otherwise it opens a window, calls
+   initGL() and then idle() whenever it has nothing else to do. */
+
+extern int width;
+extern int height;
+extern BrickWorld world;
+extern bool offscreen;			// drawing into an FBO, with no window
+extern const char* datadir;		// prefix for the shader and sound files
+extern void (*swapBuffers)();		// shows a finished frame in the window
+
+void gameOptions(int argc, char** argv);
+int runOffscreenGame();
+void initGL(int width, int height);
+void reshapeWindow(int width, int height);
+void idle();
+void draw();
+void advance();
+
+/* Arrow keys, and the modifiers held with them */
+enum GameArrow { ARROW_UP, ARROW_DOWN, ARROW_LEFT, ARROW_RIGHT };
+enum GameModifier { KEYMOD_ALT = 1, KEYMOD_CTRL = 2, KEYMOD_SHIFT = 4 };
+
+void keyCommand(unsigned char key);
+void arrowKey(int arrow, int mods);	// 'mods' exactly as held
+void zoomIn();
+void zoomOut();
+void aimAt(int x, int y);		// window coordinates
+void dragTo(int x, int y);
+
+#endif
@@ -0,0 +1,114 @@
+#include <vector>
+
+#include "glstate.h"
+
+bool statecache = true;
+struct GLStateCounts glcalls;
+struct GLStateCounts glcallslast;
+
+/* What GL is known to be set to; 'known' false means nothing is */
+static bool known;
+static GLuint program;
+static GLuint vao;
+static GLuint arraybuffer;
+static GLenum polygonmode;
+static std::vector<unsigned> attribs;	// enabled attribute bits, by VAO name
+
+void stateReset ()
+{
+	known = false;
+	attribs.clear();
+}
+
+void stateFrameEnd ()
+{
+	glcallslast = glcalls;
+	glcalls.issued = 0;
+	glcalls.elided = 0;
+}
+
+/* Read back what GL is set to, the first time it matters */
+static void know ()
+{
+	if (known)
+		return;
+	known = true;
+	GLint i;
+	glGetIntegerv (GL_CURRENT_PROGRAM, &i);
+	program = i;
+	glGetIntegerv (GL_VERTEX_ARRAY_BINDING, &i);
+	vao = i;
+	glGetIntegerv (GL_ARRAY_BUFFER_BINDING, &i);
+	arraybuffer = i;
+	polygonmode = 0;	// can't be read back alone; set on first use
+}
+
+static bool changes (bool change)
+{
+	change = change || !statecache;
+	if (change)
+		glcalls.issued++;
+	else
+		glcalls.elided++;
+	return change;
+}
+
+void stateUseProgram (GLuint p)
+{
+	know();
+	if (changes(p != program))
+	{
+		glUseProgram (p);
+		program = p;
+	}
+}
+
+void stateBindVertexArray (GLuint v)
+{
+	know();
+	if (changes(v != vao))
+	{
+		glBindVertexArray (v);
+		vao = v;
+	}
+}
+
+void stateBindArrayBuffer (GLuint b)
+{
+	know();
+	if (changes(b != arraybuffer))
+	{
+		glBindBuffer (GL_ARRAY_BUFFER, b);
+		arraybuffer = b;
+	}
+}
+
+void stateDeleteBuffer (GLuint b)
+{
+	know();
+	glDeleteBuffers (1, &b);
+	if (b == arraybuffer)
+		arraybuffer = 0;
+}
+
+void statePolygonMode (GLenum mode)
+{
+	know();
+	if (changes(mode != polygonmode))
+	{
+		glPolygonMode (GL_FRONT_AND_BACK, mode);
+		polygonmode = mode;
+	}
+}
+
+void stateEnableAttrib (GLuint index)
+{
+	know();
+	if (vao >= attribs.size())
+		attribs.resize(vao+1, 0);
+	if (changes(!(attribs[vao] & (1u << index))))
+	{
+		glEnableVertexAttribArray (index);
+		attribs[vao] |= 1u << index;
+	}
+}
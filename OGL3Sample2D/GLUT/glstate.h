@@ -0,0 +1,32 @@
+#ifndef GLSTATE_H
+#define GLSTATE_H
+
+#include "renderer.h"
+
+/* A cache of the GL state the renderer sets before its draws: the
+   program, the VAO, the GL_ARRAY_BUFFER binding, the polygon mode and
+   each VAO's enabled attributes. A call here that would leave GL as it
+   is never reaches GL, so code can set what it needs before every draw
+   without paying for it. Everything that changes this state has to go
+   through here, or call stateReset() after it. */
+
+struct GLStateCounts {
+	unsigned issued;	// calls passed on to GL
+	unsigned elided;	// calls dropped as changing nothing
+};
+
+extern bool statecache;				// false passes every call on, to compare
+extern struct GLStateCounts glcalls;		// the frame being drawn, so far
+extern struct GLStateCounts glcallslast;	// the last whole frame
+
+void stateReset();				// forget everything; GL may be in any state
+void stateFrameEnd();				// glcalls becomes glcallslast
+
+void stateUseProgram(GLuint program);
+void stateBindVertexArray(GLuint vao);
+void stateBindArrayBuffer(GLuint buffer);
+void stateDeleteBuffer(GLuint buffer);		// unbinds it, as GL does
+void statePolygonMode(GLenum mode);		// GL_FRONT_AND_BACK
+void stateEnableAttrib(GLuint index);		// of the bound VAO
+
+#endif
@@ -0,0 +1,214 @@
+#include <cstring>
+#include <cfloat>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HIT_X86 1
+#endif
+
+#include "hitkernel.h"
+
+/* Every version below follows the same steps as this one, with the same
+   rounding, so they agree bit for bit: a slab test in each axis, where a
+   ray moving parallel to an axis has to lie strictly between the box's
+   sides on that axis. The ray has to enter the box from outside, at some
+   time greater than 0. */
+static bool hitOne (const struct HitRay& r, const struct HitBox& b, float x, float y)
+{
+	float lox=-FLT_MAX, hix=FLT_MAX, loy=-FLT_MAX, hiy=FLT_MAX;
+	float x0=x+b.x0, x1=x+b.x1, y0=y+b.y0, y1=y+b.y1;
+
+	if (r.dx==0)
+	{
+		if (r.ox<=x0 || r.ox>=x1)
+			return false;
+	}
+	else
+	{
+		float ta=(x0-r.ox)/r.dx, tb=(x1-r.ox)/r.dx;
+		lox=ta<tb ? ta : tb;
+		hix=ta<tb ? tb : ta;
+	}
+	if (r.dy==0)
+	{
+		if (r.oy<=y0 || r.oy>=y1)
+			return false;
+	}
+	else
+	{
+		float ta=(y0-r.oy)/r.dy, tb=(y1-r.oy)/r.dy;
+		loy=ta<tb ? ta : tb;
+		hiy=ta<tb ? tb : ta;
+	}
+
+	float lo=lox>loy ? lox : loy;
+	float hi=hix<hiy ? hix : hiy;
+	float tnear=lo>0 ? lo : 0;
+	float tfar=hi<r.tmax ? hi : r.tmax;
+	return lo>0 && tnear<=tfar && tnear<r.tmax;
+}
+
+/* Boxes 'from' to n-1, one at a time: all of them for the portable version,
+   and the few left over after the last full vector for the others */
+static int hitsScalar (const struct HitRay& r, const struct HitBox& b, const float* x, const float* y, int from, int n, unsigned* mask)
+{
+	int i, hits=0;
+	for (i=from;i<n;i++)
+	{
+		if (hitOne(r,b,x[i],y[i]))
+		{
+			mask[i/32]|=1u<<(i%32);
+			hits++;
+		}
+	}
+	return hits;
+}
+
+#ifdef __SSE2__
+static int hitsSSE2 (const struct HitRay& r, const struct HitBox& b, const float* x, const float* y, int n, unsigned* mask)
+{
+	const __m128 zero=_mm_setzero_ps(), tmax=_mm_set1_ps(r.tmax);
+	const __m128 ox=_mm_set1_ps(r.ox), oy=_mm_set1_ps(r.oy), dx=_mm_set1_ps(r.dx), dy=_mm_set1_ps(r.dy);
+	const __m128 bx0=_mm_set1_ps(b.x0), bx1=_mm_set1_ps(b.x1), by0=_mm_set1_ps(b.y0), by1=_mm_set1_ps(b.y1);
+	int i, hits=0;
+
+	for (i=0;i+4<=n;i+=4)
+	{
+		const float* px=x+i;
+		const float* py=y+i;
+		__m128 X=_mm_loadu_ps(px), Y=_mm_loadu_ps(py);
+		__m128 x0=_mm_add_ps(X,bx0), x1=_mm_add_ps(X,bx1), y0=_mm_add_ps(Y,by0), y1=_mm_add_ps(Y,by1);
+		__m128 ok=_mm_cmpeq_ps(zero,zero);
+		__m128 lox=_mm_set1_ps(-FLT_MAX), hix=_mm_set1_ps(FLT_MAX), loy=lox, hiy=hix;
+
+		if (r.dx==0)
+			ok=_mm_and_ps(_mm_cmpgt_ps(ox,x0),_mm_cmplt_ps(ox,x1));
+		else
+		{
+			__m128 ta=_mm_div_ps(_mm_sub_ps(x0,ox),dx), tb=_mm_div_ps(_mm_sub_ps(x1,ox),dx);
+			lox=_mm_min_ps(ta,tb);
+			hix=_mm_max_ps(ta,tb);
+		}
+		if (r.dy==0)
+			ok=_mm_and_ps(ok,_mm_and_ps(_mm_cmpgt_ps(oy,y0),_mm_cmplt_ps(oy,y1)));
+		else
+		{
+			__m128 ta=_mm_div_ps(_mm_sub_ps(y0,oy),dy), tb=_mm_div_ps(_mm_sub_ps(y1,oy),dy);
+			loy=_mm_min_ps(ta,tb);
+			hiy=_mm_max_ps(ta,tb);
+		}
+
+		__m128 lo=_mm_max_ps(lox,loy), hi=_mm_min_ps(hix,hiy);
+		__m128 tnear=_mm_max_ps(lo,zero), tfar=_mm_min_ps(hi,tmax);
+		__m128 hit=_mm_and_ps(ok,_mm_cmpgt_ps(lo,zero));
+		hit=_mm_and_ps(hit,_mm_and_ps(_mm_cmple_ps(tnear,tfar),_mm_cmplt_ps(tnear,tmax)));
+
+		unsigned bits=_mm_movemask_ps(hit);
+		mask[i/32]|=bits<<(i%32);
+		hits+=__builtin_popcount(bits);
+	}
+	return hits+hitsScalar(r,b,x,y,i,n,mask);
+}
+#endif
+
+#ifdef HIT_X86
+__attribute__((target("avx2")))
+static int hitsAVX2 (const struct HitRay& r, const struct HitBox& b, const float* x, const float* y, int n, unsigned* mask)
+{
+	const __m256 zero=_mm256_setzero_ps(), tmax=_mm256_set1_ps(r.tmax);
+	const __m256 ox=_mm256_set1_ps(r.ox), oy=_mm256_set1_ps(r.oy), dx=_mm256_set1_ps(r.dx), dy=_mm256_set1_ps(r.dy);
+	const __m256 bx0=_mm256_set1_ps(b.x0), bx1=_mm256_set1_ps(b.x1), by0=_mm256_set1_ps(b.y0), by1=_mm256_set1_ps(b.y1);
+	int i, hits=0;
+
+	for (i=0;i+8<=n;i+=8)
+	{
+		const float* px=x+i;
+		const float* py=y+i;
+		__m256 X=_mm256_loadu_ps(px), Y=_mm256_loadu_ps(py);
+		__m256 x0=_mm256_add_ps(X,bx0), x1=_mm256_add_ps(X,bx1), y0=_mm256_add_ps(Y,by0), y1=_mm256_add_ps(Y,by1);
+		__m256 ok=_mm256_cmp_ps(zero,zero,_CMP_EQ_OQ);
+		__m256 lox=_mm256_set1_ps(-FLT_MAX), hix=_mm256_set1_ps(FLT_MAX), loy=lox, hiy=hix;
+
+		if (r.dx==0)
+			ok=_mm256_and_ps(_mm256_cmp_ps(ox,x0,_CMP_GT_OQ),_mm256_cmp_ps(ox,x1,_CMP_LT_OQ));
+		else
+		{
+			__m256 ta=_mm256_div_ps(_mm256_sub_ps(x0,ox),dx), tb=_mm256_div_ps(_mm256_sub_ps(x1,ox),dx);
+			lox=_mm256_min_ps(ta,tb);
+			hix=_mm256_max_ps(ta,tb);
+		}
+		if (r.dy==0)
+			ok=_mm256_and_ps(ok,_mm256_and_ps(_mm256_cmp_ps(oy,y0,_CMP_GT_OQ),_mm256_cmp_ps(oy,y1,_CMP_LT_OQ)));
+		else
+		{
+			__m256 ta=_mm256_div_ps(_mm256_sub_ps(y0,oy),dy), tb=_mm256_div_ps(_mm256_sub_ps(y1,oy),dy);
+			loy=_mm256_min_ps(ta,tb);
+			hiy=_mm256_max_ps(ta,tb);
+		}
+
+		__m256 lo=_mm256_max_ps(lox,loy), hi=_mm256_min_ps(hix,hiy);
+		__m256 tnear=_mm256_max_ps(lo,zero), tfar=_mm256_min_ps(hi,tmax);
+		__m256 hit=_mm256_and_ps(ok,_mm256_cmp_ps(lo,zero,_CMP_GT_OQ));
+		hit=_mm256_and_ps(hit,_mm256_and_ps(_mm256_cmp_ps(tnear,tfar,_CMP_LE_OQ),_mm256_cmp_ps(tnear,tmax,_CMP_LT_OQ)));
+
+		unsigned bits=_mm256_movemask_ps(hit);
+		mask[i/32]|=bits<<(i%32);
+		hits+=__builtin_popcount(bits);
+	}
+	/* hitsScalar() is built without AVX, and running it with the upper
+	   halves of the registers dirty costs more than the whole loop */
+	_mm256_zeroupper();
+	return hits+hitsScalar(r,b,x,y,i,n,mask);
+}
+#endif
+
+typedef int (*HitKernel)(const struct HitRay&, const struct HitBox&, const float*, const float*, int, unsigned*);
+
+static int hitsPortable (const struct HitRay& r, const struct HitBox& b, const float* x, const float* y, int n, unsigned* mask)
+{
+	return hitsScalar(r,b,x,y,0,n,mask);
+}
+
+/* Best version this CPU can run, picked once */
+static HitKernel pickKernel (const char** name)
+{
+#ifdef HIT_X86
+	if (__builtin_cpu_supports("avx2"))
+	{
+		*name="avx2";
+		return hitsAVX2;
+	}
+#endif
+#ifdef __SSE2__
+	*name="sse2";
+	return hitsSSE2;
+#endif
+	*name="scalar";
+	return hitsPortable;
+}
+
+static const char* kernelname;
+static const HitKernel bestkernel=pickKernel(&kernelname);
+static HitKernel kernel=bestkernel;
+
+void forceScalarHits (bool scalar)
+{
+	kernel=scalar ? hitsPortable : bestkernel;
+}
+
+int rayBoxHits (const struct HitRay& ray, const struct HitBox& box, const float* x, const float* y, int n, unsigned* mask)
+{
+	memset(mask,0,sizeof(unsigned)*((n+31)/32));
+	return kernel(ray,box,x,y,n,mask);
+}
+
+int rayBoxHitsScalar (const struct HitRay& ray, const struct HitBox& box, const float* x, const float* y, int n, unsigned* mask)
+{
+	memset(mask,0,sizeof(unsigned)*((n+31)/32));
+	return hitsScalar(ray,box,x,y,0,n,mask);
+}
+
+const char* hitKernelName ()
+{
+	return kernelname;
+}
@@ -0,0 +1,33 @@
+#ifndef HITKERNEL_H
+#define HITKERNEL_H
+
+/* Bulk ray/box test: one ray against many boxes of the same size, given
+   as contiguous arrays of their origins. Uses AVX2 or SSE2 where the CPU
+   has them and plain C++ elsewhere; all three give the same answer as
+   testing the boxes one at a time. */
+
+struct HitRay {
+	float ox, oy;		// start
+	float dx, dy;		// moved per unit of time
+	float tmax;		// only hits before this count
+};
+
+struct HitBox {
+	float x0, y0;		// corners, relative to each box's origin
+	float x1, y1;
+};
+
+/* Set bit i%32 of mask[i/32] for every box i < n that the ray enters
+   in [0, tmax), from outside it; clears the other bits. 'mask' holds
+   (n+31)/32 words. Returns the number of boxes hit. rayBoxHitsScalar()
+   is the same without the vector code, for comparison. */
+int rayBoxHits(const struct HitRay& ray, const struct HitBox& box, const float* x, const float* y, int n, unsigned* mask);
+
+int rayBoxHitsScalar(const struct HitRay& ray, const struct HitBox& box, const float* x, const float* y, int n, unsigned* mask);
+const char* hitKernelName();	// "avx2", "sse2" or "scalar"
+
+/* Make rayBoxHits() use the scalar version, or the best one again, to
+   compare whole games played with and without the vector code */
+void forceScalarHits(bool scalar);
+
+#endif
@@ -0,0 +1,162 @@
+#include <cstring>
+
+#include "inputlog.h"
+
+static void put32 (FILE* f, unsigned v)
+{
+	unsigned char b[4]={ (unsigned char)v, (unsigned char)(v>>8), (unsigned char)(v>>16), (unsigned char)(v>>24) };
+	fwrite(b,1,4,f);
+}
+
+static void putFloat (FILE* f, float x)
+{
+	unsigned v;
+	memcpy(&v,&x,4);
+	put32(f,v);
+}
+
+static bool get32 (FILE* f, unsigned* v)
+{
+	unsigned char b[4];
+	if (fread(b,1,4,f)!=4)
+		return false;
+	*v=b[0] | b[1]<<8 | b[2]<<16 | (unsigned)b[3]<<24;
+	return true;
+}
+
+static bool getFloat (FILE* f, float* x)
+{
+	unsigned v;
+	if (!get32(f,&v))
+		return false;
+	memcpy(x,&v,4);
+	return true;
+}
+
+static bool hasPosition (int type)
+{
+	return type==CMD_AIM || type==CMD_DRAG;
+}
+
+/* Start recording a game started with 'seed' */
+bool InputLog::open (const char* path, unsigned long long seed)
+{
+	f=fopen(path,"wb");
+	if (!f)
+		return false;
+	fwrite("BRKL",1,4,f);
+	put32(f,INPUTLOG_VERSION);
+	put32(f,(unsigned)seed);
+	put32(f,(unsigned)(seed>>32));
+	return true;
+}
+
+/* Record the commands applied in step 'tick' */
+void InputLog::write (unsigned tick, const BrickInputs& in)
+{
+	int i;
+	for (i=0;i<in.count;i++)
+	{
+		const struct BrickCommand& c = in.cmd[i];
+		unsigned char b[2]={ (unsigned char)c.type, (unsigned char)c.bucket };
+		put32(f,tick);
+		fwrite(b,1,2,f);
+		if (hasPosition(c.type))
+		{
+			putFloat(f,c.x);
+			putFloat(f,c.y);
+		}
+	}
+}
+
+/* Mark the end of a game that ran for 'ticks' steps */
+void InputLog::close (unsigned ticks)
+{
+	unsigned char b[2]={ LOG_END, 0 };
+	put32(f,ticks);
+	fwrite(b,1,2,f);
+	fclose(f);
+	f=0;
+}
+
+bool InputReplay::open (const char* path)
+{
+	char magic[4];
+	unsigned version, lo, hi;
+
+	f=fopen(path,"rb");
+	if (!f)
+		return false;
+	if (fread(magic,1,4,f)!=4 || memcmp(magic,"BRKL",4) || !get32(f,&version) || version!=INPUTLOG_VERSION
+		|| !get32(f,&lo) || !get32(f,&hi))
+	{
+		fclose(f);
+		f=0;
+		return false;
+	}
+	seed=lo | (unsigned long long)hi<<32;
+	fetch();
+	return true;
+}
+
+/* Read the next command. A log cut short, say by a crash, ends after the
+   last step it has commands for. One with a command type or bucket out of
+   range is damaged, and ends before that command, flagged as corrupt:
+   the world would index its buckets with it. */
+void InputReplay::fetch ()
+{
+	unsigned char b[2];
+	unsigned t;
+
+	have=false;
+	if (ended)
+		return;
+	if (!get32(f,&t) || fread(b,1,2,f)!=2
+		|| (hasPosition(b[0]) && (!getFloat(f,&cmd.x) || !getFloat(f,&cmd.y))))
+	{
+		ended=true;
+		end=tick+1;
+		return;
+	}
+	tick=t;
+	if (b[0]==LOG_END)
+	{
+		ended=true;
+		end=t;
+		return;
+	}
+	if (b[0]>CMD_FIRE || b[1]>1)
+	{
+		ended=true;
+		corrupt=true;
+		end=tick;
+		return;
+	}
+	cmd.type=b[0];
+	cmd.bucket=b[1];
+	if (!hasPosition(cmd.type))
+		cmd.x=cmd.y=0;
+	have=true;
+}
+
+/* Fill 'in' with the commands recorded for step 'tick' */
+bool InputReplay::read (unsigned t, BrickInputs& in)
+{
+	in.clear();
+	if (ended && !have && t>=end)
+		return false;
+	while (have && tick<=t)
+	{
+		if (tick==t)
+			in.push(cmd.type,cmd.bucket,cmd.x,cmd.y);
+		fetch();
+	}
+	return true;
+}
+
+void InputReplay::close ()
+{
+	if (f)
+		fclose(f);
+	f=0;
+}
@@ -0,0 +1,51 @@
+#ifndef INPUTLOG_H
+#define INPUTLOG_H
+
+#include <cstdio>
+
+#include "brickworld.h"
+
+/* Recording of a game: the seed it started with and every player command,
+   stamped with the step it was applied in. Replaying the commands into a
+   world initialised with the same seed plays the game out again exactly.
+
+   File layout, little endian:
+     header   "BRKL", u32 version, u64 seed
+     command  u32 tick, u8 type, u8 bucket, and f32 x, f32 y for CMD_AIM
+              and CMD_DRAG only
+     end      u32 tick, u8 LOG_END: steps the game ran for */
+
+#define INPUTLOG_VERSION 1
+#define LOG_END 0xff
+
+struct InputLog {
+	FILE* f;
+
+	InputLog() : f(0) {}
+	bool open(const char* path, unsigned long long seed);
+	void write(unsigned tick, const BrickInputs& in);
+	void close(unsigned ticks);
+};
+
+struct InputReplay {
+	FILE* f;
+	unsigned long long seed;
+	unsigned end;		// steps the recorded game ran for, once known
+	bool ended;
+	bool corrupt;		// ended at a command no game could have recorded
+
+	/* Next command, read ahead of the step it belongs to */
+	bool have;
+	unsigned tick;
+	struct BrickCommand cmd;
+
+	InputReplay() : f(0), seed(0), end(0), ended(false), corrupt(false), have(false), tick(0) {}
+	bool open(const char* path);
+	bool read(unsigned tick, BrickInputs& in);	// false once the recording is over
+	void close();
+
+private:
+	void fetch();
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include <cstdio>
+#include <vector>
+
+#include "brickworld.h"
+#include "inputlog.h"
+
+/* Records a game with every kind of command in it, then replays it whole,
+   cut short at every byte, and with a command type or bucket damaged.
+   A cut log has to play the commands before the cut and stop; a damaged
+   one has to stop before the bad command and say it is corrupt. No replay
+   may hand the world a command out of range.
+
+   usage: inputlog_test		exits 1 on the first failure */
+
+#define LOG "inputlog_test.log"
+#define TICKS 200
+#define HEADER 16		// "BRKL", version, seed
+
+struct Played {
+	int commands;
+	bool corrupt;
+	unsigned end;
+	bool inrange;
+};
+
+static std::vector<unsigned char> readFile (const char* path)
+{
+	std::vector<unsigned char> b;
+	FILE* f=fopen(path,"rb");
+	int c;
+	while (f && (c=fgetc(f))!=EOF)
+		b.push_back((unsigned char)c);
+	if (f)
+		fclose(f);
+	return b;
+}
+
+static void writeFile (const char* path, const std::vector<unsigned char>& b, size_t n)
+{
+	FILE* f=fopen(path,"wb");
+	fwrite(b.data(),1,n,f);
+	fclose(f);
+}
+
+/* A game with one command a step, going through all of them and both
+   buckets; returns the offset of each command in the file */
+static std::vector<size_t> record ()
+{
+	struct InputLog log;
+	BrickInputs in;
+	std::vector<size_t> offsets;
+	size_t at=HEADER;
+	unsigned t;
+
+	log.open(LOG,7);
+	for (t=0;t<TICKS;t++)
+	{
+		int type=t%(CMD_FIRE+1);
+		in.clear();
+		in.push(type,t/(CMD_FIRE+1)%2,-3.2f+t%7*0.1f,t%5*0.3f);
+		log.write(t,in);
+		offsets.push_back(at);
+		at+=type==CMD_AIM || type==CMD_DRAG ? 14 : 6;
+	}
+	log.close(TICKS);
+	return offsets;
+}
+
+static struct Played replay (const char* path)
+{
+	struct Played p={ 0, false, 0, true };
+	struct InputReplay r;
+	static BrickWorld world;
+	BrickInputs in;
+	int i;
+
+	if (!r.open(path))
+		return p;
+	world.init(r.seed);
+	while (r.read(world.ticks,in) && world.ticks<TICKS*2)
+	{
+		for (i=0;i<in.count;i++)
+			if (in.cmd[i].type<0 || in.cmd[i].type>CMD_FIRE || in.cmd[i].bucket<0 || in.cmd[i].bucket>1)
+				p.inrange=false;
+		p.commands+=in.count;
+		world.step(in);
+	}
+	r.close();
+	p.corrupt=r.corrupt;
+	p.end=r.end;
+	return p;
+}
+
+int main ()
+{
+	std::vector<size_t> offsets=record();
+	std::vector<unsigned char> whole=readFile(LOG);
+	struct Played p;
+	size_t n;
+	int k, cuts=0, damaged=0;
+
+	p=replay(LOG);
+	if (p.commands!=TICKS || p.corrupt || p.end!=TICKS || !p.inrange)
+	{
+		printf("FAIL: whole log: %d commands, corrupt %d, end %u\n",p.commands,p.corrupt,p.end);
+		return 1;
+	}
+
+	for (n=HEADER;n<whole.size();n++,cuts++)
+	{
+		writeFile(LOG,whole,n);
+		p=replay(LOG);
+		if (p.corrupt || !p.inrange || p.commands>TICKS)
+		{
+			printf("FAIL: log cut at byte %zu: %d commands, corrupt %d\n",n,p.commands,p.corrupt);
+			return 1;
+		}
+	}
+
+	for (k=0;k<TICKS;k+=7)
+	{
+		// byte 4 of a command is its type, byte 5 its bucket
+		static const int bad[][2]={ { 5, 2 }, { 5, 255 }, { 4, CMD_FIRE+1 }, { 4, LOG_END-1 } };
+		int j;
+		for (j=0;j<4;j++,damaged++)
+		{
+			std::vector<unsigned char> b=whole;
+			b[offsets[k]+bad[j][0]]=(unsigned char)bad[j][1];
+			writeFile(LOG,b,b.size());
+			p=replay(LOG);
+			if (!p.corrupt || !p.inrange || p.commands!=k || p.end!=(unsigned)k)
+			{
+				printf("FAIL: command %d damaged to type %d bucket %d: %d commands, corrupt %d, end %u\n",
+					k,b[offsets[k]+4],b[offsets[k]+5],p.commands,p.corrupt,p.end);
+				return 1;
+			}
+		}
+	}
+	remove(LOG);
+	printf("ok: %d cut and %d damaged logs stop where they should\n",cuts,damaged);
+	return 0;
+}
@@ -0,0 +1,341 @@
+#include <cmath>
+
+#include "brickworld.h"
+#include "hitkernel.h"
+
+/* The shot is traced analytically: from the tip, find the first mirror or
+   brick the tip runs into, reflect, and repeat until it leaves range or
+   hits a brick that stops it. All bricks fall at the same speed, so in a
+   frame falling with them they stand still and the tip still moves in a
+   straight line; that turns each brick test into a plain ray/box test,
+   and a grid of the bricks built once per trace stays valid for every
+   segment of it. */
+
+/* Time at which a point starting at (ox,oy) and moving by (dx,dy) per step
+   enters the box, if that is in [0,tmax]. 'face' is set to 0 for the left
+   or right side and 1 for the top or bottom. Returns -1 on a miss, and
+   also when the point starts inside the box. */
+static float rayBox (float ox, float oy, float dx, float dy, float x0, float y0, float x1, float y1, float tmax, int* face)
+{
+	float tnear=0, tfar=tmax;
+	int f=-1;
+
+	if (dx==0)
+	{
+		if (ox<=x0 || ox>=x1)
+			return -1;
+	}
+	else
+	{
+		float ta=(x0-ox)/dx, tb=(x1-ox)/dx;
+		if (ta>tb)
+		{
+			float tmp=ta;
+			ta=tb;
+			tb=tmp;
+		}
+		if (ta>tnear)
+		{
+			tnear=ta;
+			f=0;
+		}
+		if (tb<tfar)
+			tfar=tb;
+	}
+
+	if (dy==0)
+	{
+		if (oy<=y0 || oy>=y1)
+			return -1;
+	}
+	else
+	{
+		float ta=(y0-oy)/dy, tb=(y1-oy)/dy;
+		if (ta>tb)
+		{
+			float tmp=ta;
+			ta=tb;
+			tb=tmp;
+		}
+		if (ta>tnear)
+		{
+			tnear=ta;
+			f=1;
+		}
+		if (tb<tfar)
+			tfar=tb;
+	}
+
+	if (f<0 || tnear>tfar)
+		return -1;
+	*face=f;
+	return tnear;
+}
+
+/* Time at which the point crosses the segment (ax,ay)-(bx,by), or -1 */
+static float raySegment (float ox, float oy, float dx, float dy, float ax, float ay, float bx, float by, float tmax)
+{
+	float ex=bx-ax, ey=by-ay;
+	float denom=dx*ey-dy*ex;
+	if (denom==0)
+		return -1;
+	float t=((ax-ox)*ey-(ay-oy)*ex)/denom;
+	float s=((ax-ox)*dy-(ay-oy)*dx)/denom;
+	if (t<0 || t>tmax || s<0 || s>1)
+		return -1;
+	return t;
+}
+
+/* Brick boxes, relative to a brick's origin */
+static const struct HitBox brickbox={ -0.1f, 3.5f, 0.1f, 3.7f };
+
+/* The first of grid bricks items[first] .. items[first+count-1] the ray
+   enters before *best, other than 'last', or -1; *best and *face are set
+   for it. The kernel picks out the bricks the ray can hit at all, and
+   only those are tested again one by one. */
+static int nearestBrick (const BrickPool& bricks, BrickGrid& grid, const struct HitRay& ray, int first, int count, int last, float* best, int* face)
+{
+	grid.hits.resize((count+31)/32);
+	if (rayBoxHits(ray,brickbox,&grid.itemx[first],&grid.itemy[first],count,grid.hits.data())==0)
+		return -1;
+
+	int no=-1, w;
+	for (w=0;w<(count+31)/32;w++)
+	{
+		unsigned bits=grid.hits[w];
+		while (bits)
+		{
+			int i=grid.items[first+w*32+__builtin_ctz(bits)];
+			bits&=bits-1;
+			if (i==last)
+				continue;
+			float bx=bricks.x[i], by=bricks.y[i];
+			int f;
+			float th=rayBox(ray.ox,ray.oy,ray.dx,ray.dy,bx-0.1f,by+3.5f,bx+0.1f,by+3.7f,*best,&f);
+			if (th>=0 && th<*best)
+			{
+				*best=th;
+				*face=f;
+				no=i;
+			}
+		}
+	}
+	return no;
+}
+
+/* Direction after bouncing off an upright (face 0) or flat (face 1) side */
+static float reflectAngle (float angle, int face)
+{
+	return face==0 ? 180-angle : -angle;
+}
+
+/* Trace a shot whose tip is at (x,y) heading 'angle' at time t0, with
+   'range' units left to go. Bricks are taken to sit at their current
+   position one step after t0, which is when this step moves them.
+   Fills 'path' and returns the number of nodes; the last one is always
+   NODE_BRICK or NODE_END. */
+int BrickWorld::traceLaser (float x, float y, float angle, float t0, float range, struct LaserNode* path)
+{
+	const float diagx=-M_SQRT1_2, diagy=1+M_SQRT1_2;	// far end of the diagonal mirror
+	int n=0;
+	int last=-1;	// brick slot, or -2/-3 for the mirrors, just bounced off
+	float t=t0;
+
+	path[n].t=t;
+	path[n].x=x;
+	path[n].y=y;
+	path[n].angle=angle;
+	path[n].range=range;
+	path[n].kind=NODE_START;
+	path[n].no=-1;
+	n++;
+
+	grid.build(bricks);
+	while (1)
+	{
+		float ux=LASER_SPEED*cos(angle*M_PI/180.0f);
+		float uy=LASER_SPEED*sin(angle*M_PI/180.0f);
+		float best=range/LASER_SPEED;
+		int kind=NODE_END, no=-1, face=0;
+		int f;
+		float th;
+
+		if (last!=-2)
+		{
+			th=rayBox(x,y,ux,uy,3.0f,0.0f,3.1f,1.0f,best,&f);
+			if (th>=0 && th<best)
+			{
+				best=th;
+				kind=NODE_SIDE_MIRROR;
+				face=f;
+			}
+		}
+		if (last!=-3)
+		{
+			th=raySegment(x,y,ux,uy,0.0f,1.0f,diagx,diagy,best);
+			if (th>=0 && th<best)
+			{
+				best=th;
+				kind=NODE_MIRROR;
+			}
+		}
+
+		/* Bricks, seen from a frame that falls with them. The cells come
+		   in the order the tip reaches them, so stop at the first cell
+		   that starts beyond the nearest hit so far. Cells that follow
+		   each other along a row keep their bricks next to each other in
+		   the grid, so each run of them is tested in one pass. */
+		float gy=y-brickspeed*(t-(t0+1));
+		struct GridWalk walk;
+		const int *it, *end;
+		float tcell;
+		int first=0, count=0;
+		walk.init(grid,x,gy,ux,uy-brickspeed,best);
+		while (1)
+		{
+			bool more=walk.next(&it,&end,&tcell) && tcell<=best;
+			if (more && it-grid.items.data()==first+count)
+			{
+				count+=end-it;
+				continue;
+			}
+			if (count>0)
+			{
+				struct HitRay ray={ x, gy, ux, uy-brickspeed, best };
+				int i=nearestBrick(bricks,grid,ray,first,count,last,&best,&f);
+				if (i>=0)
+				{
+					kind=bricks.col[i]==BRICK_GREEN ? NODE_GREEN : NODE_BRICK;
+					no=i;
+					face=f;
+				}
+			}
+			if (!more)
+				break;
+			first=it-grid.items.data();
+			count=end-it;
+		}
+
+		x+=ux*best;
+		y+=uy*best;
+		t+=best;
+		range-=LASER_SPEED*best;
+		if (kind==NODE_SIDE_MIRROR)
+		{
+			angle=reflectAngle(angle,face);
+			range=LASER_RANGE;
+			last=-2;
+		}
+		if (kind==NODE_MIRROR)
+		{
+			angle=270-angle;
+			last=-3;
+		}
+		if (kind==NODE_GREEN)
+		{
+			angle=reflectAngle(angle,face);
+			last=no;
+		}
+		if (n==MAX_LASER_NODES-1 && kind!=NODE_BRICK)
+			kind=NODE_END;
+
+		path[n].t=t;
+		path[n].x=x;
+		path[n].y=y;
+		path[n].angle=angle;
+		path[n].range=range;
+		path[n].kind=kind;
+		path[n].no=no;
+		n++;
+		if (kind==NODE_BRICK || kind==NODE_END)
+			return n;
+	}
+}
+
+bool BrickWorld::laserFlying () const
+{
+	return laser.flying;
+}
+
+/* Start a shot from the cannon */
+void BrickWorld::fireLaser ()
+{
+	float angle=laser.laser_rotation;
+	float tipx=laser.x+LASER_LENGTH*cos(angle*M_PI/180.0f);
+	float tipy=laser.y+LASER_LENGTH*sin(angle*M_PI/180.0f);
+
+	laser.flying=1;
+	laser.t=0;
+	laser.node=0;
+	laser.nnodes=traceLaser(tipx,tipy,angle,0,LASER_RANGE,laser.path);
+	laser.stale=0;
+}
+
+/* Trace the rest of the path again from where the tip is now */
+void BrickWorld::retraceLaser ()
+{
+	struct LaserNode n=laser.path[laser.node];
+	float dt=laser.t-n.t;
+	float x=n.x+LASER_SPEED*dt*cos(n.angle*M_PI/180.0f);
+	float y=n.y+LASER_SPEED*dt*sin(n.angle*M_PI/180.0f);
+
+	laser.node=0;
+	laser.nnodes=traceLaser(x,y,n.angle,laser.t,n.range-LASER_SPEED*dt,laser.path);
+	laser.stale=0;
+}
+
+/* Move the shot on by one step, scoring whatever its tip reaches */
+void BrickWorld::advanceLaser ()
+{
+	if (laser.stale)
+		retraceLaser();
+
+	float t=laser.t+1;
+	while (laser.node+1<laser.nnodes && laser.path[laser.node+1].t<=t)
+	{
+		laser.node++;
+		struct LaserNode& n = laser.path[laser.node];
+		if (n.kind==NODE_GREEN)
+		{
+			laserHit(BRICK_GREEN);
+		}
+		if (n.kind==NODE_BRICK)
+		{
+			laserHit(bricks.col[n.no]);
+			bricks.release(n.no);
+			laser.flying=0;
+			return;
+		}
+		if (n.kind==NODE_END)
+		{
+			laser.flying=0;
+			return;
+		}
+	}
+	laser.t=t;
+	placeLaser();
+}
+
+/* Put the laser where its tip is at time laser.t */
+void BrickWorld::placeLaser ()
+{
+	struct LaserNode& n = laser.path[laser.node];
+	float cx=cos(n.angle*M_PI/180.0f), cy=sin(n.angle*M_PI/180.0f);
+	float dt=laser.t-n.t;
+	laser.x=n.x+(LASER_SPEED*dt-LASER_LENGTH)*cx;
+	laser.y=n.y+(LASER_SPEED*dt-LASER_LENGTH)*cy;
+	laser.laser_rotation=n.angle;
+}
+
+/* Put the laser back into the cannon */
+void BrickWorld::resetLaser ()
+{
+	laser.x=-3.5f;
+	laser.y=cannon.y;
+	laser.laser_rotation=cannon.cannon_rotation;
+	laser.flying=0;
+	laser.t=0;
+	laser.node=0;
+	laser.nnodes=0;
+	laser.stale=0;
+}
@@ -0,0 +1,183 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "renderer.h"
+#ifndef NO_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+#include "offscreen.h"
+
+static GLuint fbo, colorbuffer, depthbuffer;
+static int fbwidth, fbheight;
+
+#ifndef NO_EGL
+static EGLDisplay display = EGL_NO_DISPLAY;
+static EGLContext context = EGL_NO_CONTEXT;
+static EGLSurface surface = EGL_NO_SURFACE;
+
+static bool hasExtension (const char* list, const char* name)
+{
+	size_t n = strlen(name);
+	const char* p = list;
+	while (p && (p = strstr(p, name)))
+	{
+		if ((p == list || p[-1] == ' ') && (p[n] == ' ' || p[n] == 0))
+			return true;
+		p += n;
+	}
+	return false;
+}
+
+/* Surfaceless display if Mesa offers it, the default display otherwise */
+static EGLDisplay openDisplay ()
+{
+	const char* clientext = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+		(PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+	if (getPlatformDisplay && hasExtension(clientext, "EGL_MESA_platform_surfaceless"))
+	{
+		EGLDisplay d = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+		if (d != EGL_NO_DISPLAY && eglInitialize(d, NULL, NULL))
+			return d;
+	}
+
+	EGLDisplay d = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	if (d != EGL_NO_DISPLAY && eglInitialize(d, NULL, NULL))
+		return d;
+	return EGL_NO_DISPLAY;
+}
+
+bool initOffscreenContext ()
+{
+	display = openDisplay();
+	if (display == EGL_NO_DISPLAY)
+	{
+		fprintf(stderr, "offscreen: no EGL display\n");
+		return false;
+	}
+	if (!eglBindAPI(EGL_OPENGL_API))
+	{
+		fprintf(stderr, "offscreen: EGL has no desktop OpenGL\n");
+		return false;
+	}
+
+	const EGLint configattribs[] = {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_NONE
+	};
+	EGLConfig config;
+	EGLint n = 0;
+	eglChooseConfig(display, configattribs, &config, 1, &n);
+	if (n == 0)
+	{
+		fprintf(stderr, "offscreen: no EGL config for OpenGL\n");
+		return false;
+	}
+
+	const EGLint contextattribs[] = {
+		EGL_CONTEXT_MAJOR_VERSION, 3,
+		EGL_CONTEXT_MINOR_VERSION, 3,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE
+	};
+	context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextattribs);
+	if (context == EGL_NO_CONTEXT)
+	{
+		fprintf(stderr, "offscreen: can't create a GL 3.3 core context\n");
+		return false;
+	}
+
+	// Everything is drawn into the FBO, so a surface is only made if EGL insists on one
+	if (!hasExtension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context"))
+	{
+		const EGLint pbufferattribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+		surface = eglCreatePbufferSurface(display, config, pbufferattribs);
+	}
+	if (!eglMakeCurrent(display, surface, surface, context))
+	{
+		fprintf(stderr, "offscreen: can't make the context current\n");
+		return false;
+	}
+	return true;
+}
+
+void* offscreenProcAddress (const char* name)
+{
+	return (void*) eglGetProcAddress(name);
+}
+
+void closeOffscreen ()
+{
+	if (display == EGL_NO_DISPLAY)
+		return;
+	eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	if (surface != EGL_NO_SURFACE)
+		eglDestroySurface(display, surface);
+	if (context != EGL_NO_CONTEXT)
+		eglDestroyContext(display, context);
+	eglTerminate(display);
+	display = EGL_NO_DISPLAY;
+}
+#else
+/* Built with -DNO_EGL, where there is no EGL (Mac OS X) */
+bool initOffscreenContext ()
+{
+	fprintf(stderr, "offscreen: built without EGL\n");
+	return false;
+}
+
+void* offscreenProcAddress (const char* name)
+{
+	return NULL;
+}
+
+void closeOffscreen ()
+{
+}
+#endif
+
+/* Colour and depth renderbuffers the size of the window it stands in for */
+void initOffscreenFramebuffer (int width, int height)
+{
+	fbwidth = width;
+	fbheight = height;
+
+	glGenFramebuffers (1, &fbo);
+	glBindFramebuffer (GL_FRAMEBUFFER, fbo);
+
+	glGenRenderbuffers (1, &colorbuffer);
+	glBindRenderbuffer (GL_RENDERBUFFER, colorbuffer);
+	glRenderbufferStorage (GL_RENDERBUFFER, GL_RGBA8, width, height);
+	glFramebufferRenderbuffer (GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorbuffer);
+
+	glGenRenderbuffers (1, &depthbuffer);
+	glBindRenderbuffer (GL_RENDERBUFFER, depthbuffer);
+	glRenderbufferStorage (GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	glFramebufferRenderbuffer (GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthbuffer);
+
+	if (glCheckFramebufferStatus (GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		fprintf(stderr, "offscreen: framebuffer is incomplete\n");
+}
+
+bool dumpFrame (const char* path)
+{
+	std::vector<unsigned char> pixels (fbwidth*fbheight*3);
+	glPixelStorei (GL_PACK_ALIGNMENT, 1);
+	glReadPixels (0, 0, fbwidth, fbheight, GL_RGB, GL_UNSIGNED_BYTE, &pixels[0]);
+
+	FILE* f = fopen(path, "wb");
+	if (!f)
+		return false;
+	fprintf(f, "P6\n%d %d\n255\n", fbwidth, fbheight);
+	// GL rows go bottom up, image rows top down
+	int y;
+	for (y = fbheight-1; y >= 0; y--)
+		fwrite(&pixels[y*fbwidth*3], 1, fbwidth*3, f);
+	fclose(f);
+	return true;
+}
@@ -0,0 +1,18 @@
+#ifndef OFFSCREEN_H
+#define OFFSCREEN_H
+
+/* Rendering with no window, for machines without a display or a GPU.
+   The context comes from EGL, on Mesa's surfaceless platform if it is
+   there (llvmpipe needs nothing else), otherwise on the default display
+   with a small pbuffer. Frames are drawn into a framebuffer object.
+
+   Call initOffscreenContext() first, load the GL functions with
+   offscreenProcAddress(), then call initOffscreenFramebuffer(). */
+
+bool initOffscreenContext();		// false if no GL 3.3 core context can be had
+void* offscreenProcAddress(const char* name);
+void initOffscreenFramebuffer(int width, int height);
+bool dumpFrame(const char* path);	// saves the framebuffer as a .ppm file
+void closeOffscreen();
+
+#endif
@@ -0,0 +1,112 @@
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+#include "profile.h"
+
+static const char* section_names[NUM_PROF_SECTIONS]={
+	"frame", "input", "step", "spawn", "collide", "move",
+	"scene", "upload", "submit", "swap", "gpu"
+};
+
+std::atomic<bool> profiling(false);
+static const char* csvfile;
+static std::atomic<unsigned> frame(0);
+
+/* Writers claim a slot with one atomic add and never wait on each other;
+   once the ring is full the oldest records are overwritten. */
+static struct ProfileRecord* ring;
+static std::atomic<unsigned long long> head(0);
+
+static void profileDump();
+
+/* Turn recording on, and have the records written out at exit */
+void profileStart (const char* csvpath)
+{
+	if (profiling)
+		return;
+	ring=new struct ProfileRecord[PROFILE_RING];
+	csvfile=csvpath;
+	profiling=true;
+	atexit(profileDump);
+}
+
+void profileFrame ()
+{
+	frame++;
+}
+
+unsigned profileFrameNo ()
+{
+	return frame.load(std::memory_order_relaxed);
+}
+
+long long profileNow ()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void profileRecord (int section, long long ns)
+{
+	profileRecordAt(section,profileFrameNo(),ns);
+}
+
+void profileRecordAt (int section, unsigned frameno, long long ns)
+{
+	unsigned long long slot=head.fetch_add(1,std::memory_order_relaxed);
+	struct ProfileRecord& r=ring[slot%PROFILE_RING];
+	r.frame=frameno;
+	r.section=section;
+	r.ns=ns;
+}
+
+/* Write the ring as CSV, if asked to, and a per-section summary to stderr */
+static void profileDump ()
+{
+	profiling=false;
+	unsigned long long n=head.load();
+	unsigned long long first=n>PROFILE_RING ? n-PROFILE_RING : 0;
+	unsigned long long i;
+
+	if (csvfile)
+	{
+		FILE* f=fopen(csvfile,"w");
+		if (f)
+		{
+			fprintf(f,"frame,section,ns\n");
+			for (i=first;i<n;i++)
+			{
+				const struct ProfileRecord& r=ring[i%PROFILE_RING];
+				fprintf(f,"%u,%s,%lld\n",r.frame,section_names[r.section],r.ns);
+			}
+			fclose(f);
+		}
+		else
+			fprintf(stderr,"profile: can't write %s\n",csvfile);
+	}
+
+	std::vector<long long> times[NUM_PROF_SECTIONS];
+	for (i=first;i<n;i++)
+		times[ring[i%PROFILE_RING].section].push_back(ring[i%PROFILE_RING].ns);
+
+	fprintf(stderr,"\n%-8s %8s %10s %10s %10s %10s\n","section","count","mean us","p50 us","p99 us","max us");
+	int s;
+	for (s=0;s<NUM_PROF_SECTIONS;s++)
+	{
+		std::vector<long long>& t=times[s];
+		if (t.empty())
+			continue;
+		std::sort(t.begin(),t.end());
+		double sum=0;
+		size_t k;
+		for (k=0;k<t.size();k++)
+			sum+=t[k];
+		fprintf(stderr,"%-8s %8zu %10.2f %10.2f %10.2f %10.2f\n",section_names[s],t.size(),
+			sum/t.size()/1000,t[t.size()/2]/1000.0,t[(size_t)(t.size()*0.99)]/1000.0,t.back()/1000.0);
+	}
+	if (first>0)
+		fprintf(stderr,"(last %d records only)\n",PROFILE_RING);
+}
@@ -0,0 +1,57 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <atomic>
+
+/* Timings of the parts of a frame, for finding out where the time goes.
+   Every measurement is appended to a lock-free ring of the most recent
+   PROFILE_RING records, tagged with the frame it was taken in, and the
+   ring is written out when the program exits. Nothing is recorded until
+   profileStart() is called, and a disabled ProfileScope costs one test. */
+
+#define PROFILE_RING (1<<18)
+
+enum ProfileSection {
+	PROF_FRAME,	// all of draw()
+	PROF_INPUT,	// keyboard handler
+	PROF_STEP,	// one world step
+	PROF_SPAWN,	// spawning a brick
+	PROF_COLLIDE,	// moving the laser, tracing it and scoring its hits
+	PROF_MOVE,	// moving and collecting the bricks
+	PROF_SCENE,	// uniforms and draws for the fixed objects
+	PROF_UPLOAD,	// packing the brick instances and their uniforms
+	PROF_SUBMIT,	// the instanced brick draw, buffer upload included
+	PROF_SWAP,	// glutSwapBuffers
+	PROF_GPU,	// GPU time of a frame, from a timer query
+	NUM_PROF_SECTIONS
+};
+
+struct ProfileRecord {
+	unsigned frame;
+	int section;
+	long long ns;
+};
+
+/* Read by the batch tools' worker threads too. profileStart() must run
+   before they are started, so they see the ring it allocates */
+extern std::atomic<bool> profiling;
+
+inline bool profileEnabled() { return profiling.load(std::memory_order_relaxed); }
+
+void profileStart(const char* csvpath);	// csvpath may be NULL for a summary only
+void profileFrame();			// the following records belong to the next frame
+unsigned profileFrameNo();
+void profileRecord(int section, long long ns);
+void profileRecordAt(int section, unsigned frame, long long ns);	// for an earlier frame
+long long profileNow();			// nanoseconds on a steady clock
+
+/* Times the enclosing block */
+struct ProfileScope {
+	int section;
+	long long t0;
+
+	ProfileScope(int s) : section(s), t0(profileEnabled() ? profileNow() : 0) {}
+	~ProfileScope() { if (profileEnabled()) profileRecord(section, profileNow()-t0); }
+};
+
+#endif
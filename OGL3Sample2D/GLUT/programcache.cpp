@@ -0,0 +1,111 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "programcache.h"
+
+std::string programcache;
+
+struct ProgramCacheHeader {
+	char magic[4];
+	unsigned version;
+	unsigned long long key;
+	unsigned format;
+	unsigned length;
+};
+
+bool programCacheUsable ()
+{
+	if (programcache.empty() || !GL_HAS(ARB_get_program_binary))
+		return false;
+	GLint formats = 0;
+	glGetIntegerv (GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	return formats > 0;
+}
+
+/* 64-bit FNV-1a, with a zero byte ending each string so that moving text
+   from one to the next changes the key */
+static void hashString (unsigned long long* h, const char* s)
+{
+	do
+	{
+		*h ^= (unsigned char)*s;
+		*h *= 1099511628211ULL;
+	} while (*s++);
+}
+
+unsigned long long programKey (const std::string& vertex, const std::string& fragment)
+{
+	unsigned long long h = 14695981039346656037ULL;
+	hashString(&h, vertex.c_str());
+	hashString(&h, fragment.c_str());
+	hashString(&h, (const char*) glGetString (GL_VENDOR));
+	hashString(&h, (const char*) glGetString (GL_RENDERER));
+	hashString(&h, (const char*) glGetString (GL_VERSION));
+	return h;
+}
+
+GLuint loadCachedProgram (unsigned long long key)
+{
+	FILE* f = fopen(programcache.c_str(), "rb");
+	if (!f)
+		return 0;
+
+	struct ProgramCacheHeader h;
+	std::vector<char> binary;
+	bool ok = fread(&h, sizeof(h), 1, f) == 1 && memcmp(h.magic, "GLPB", 4) == 0
+		&& h.version == PROGRAMCACHE_VERSION && h.key == key && h.length > 0;
+	if (ok)
+	{
+		binary.resize(h.length);
+		ok = fread(&binary[0], 1, h.length, f) == h.length;
+	}
+	fclose(f);
+	if (!ok)
+		return 0;
+
+	// A driver update can leave the key alone yet refuse the binary; the
+	// link status says whether it took it
+	GLuint program = glCreateProgram();
+	glProgramBinary (program, h.format, &binary[0], h.length);
+	GLint linked = GL_FALSE;
+	glGetProgramiv (program, GL_LINK_STATUS, &linked);
+	if (!linked)
+	{
+		glDeleteProgram (program);
+		return 0;
+	}
+	return program;
+}
+
+void saveCachedProgram (unsigned long long key, GLuint program)
+{
+	GLint length = 0;
+	glGetProgramiv (program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
+	std::vector<char> binary(length);
+	GLenum format;
+	glGetProgramBinary (program, length, &length, &format, &binary[0]);
+	if (length <= 0)
+		return;
+
+	struct ProgramCacheHeader h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, "GLPB", 4);
+	h.version = PROGRAMCACHE_VERSION;
+	h.key = key;
+	h.format = format;
+	h.length = length;
+
+	// Written aside and renamed over the old file, so a start cut short
+	// never leaves half a binary behind
+	std::string tmp = programcache + ".tmp";
+	FILE* f = fopen(tmp.c_str(), "wb");
+	if (!f)
+		return;
+	bool ok = fwrite(&h, sizeof(h), 1, f) == 1 && fwrite(&binary[0], 1, length, f) == (size_t)length;
+	ok = fclose(f) == 0 && ok;
+	if (!ok || rename(tmp.c_str(), programcache.c_str()) != 0)
+		remove(tmp.c_str());
+}
@@ -0,0 +1,34 @@
+#ifndef PROGRAMCACHE_H
+#define PROGRAMCACHE_H
+
+#include <string>
+
+#include "renderer.h"
+
+/* Linked programs kept on disk, so a later start on the same driver
+   loads one with glProgramBinary instead of compiling its shaders. The
+   file is tagged with a hash of the shader sources and of GL_VENDOR,
+   GL_RENDERER and GL_VERSION. A file made for anything else, a damaged
+   one, or a binary the driver turns down just means compiling as before
+   and saving over it.
+
+   File layout, in the byte order of the machine that wrote it (nothing
+   else could load the binary anyway):
+     "GLPB", u32 version, u64 key, u32 binary format, u32 length, binary */
+
+#define PROGRAMCACHE_VERSION 1
+
+extern std::string programcache;	// the file; empty always compiles
+
+/* Whether the driver can hand back program binaries at all */
+bool programCacheUsable();
+
+unsigned long long programKey(const std::string& vertex, const std::string& fragment);
+
+/* The program saved under 'key', linked and ready, or 0 */
+GLuint loadCachedProgram(unsigned long long key);
+
+/* 'program' must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT */
+void saveCachedProgram(unsigned long long key, GLuint program);
+
+#endif
@@ -0,0 +1,367 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <map>
+#include <string>
+#include <iterator>
+#include <cstdio>
+#include <cmath>
+#include <cstddef>
+
+#include "renderer.h"
+#include "streambuffer.h"
+#include "glstate.h"
+#include "programcache.h"
+#include "profile.h"
+
+using namespace std;
+
+struct GLMatrices Matrices;
+
+bool loadGL (GLGetProc getproc)
+{
+#ifdef USE_GLAD
+    if (!gladLoadGLLoader((GLADloadproc) getproc)) {
+        cout << "Error: Failed to load the GL functions" << endl;
+        return false;
+    }
+#else
+    glewExperimental = GL_TRUE;
+    GLenum err = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // A GLX build of GLEW still loads the GL functions under EGL, it only
+    // fails to find GLX extensions there
+    if (err == GLEW_ERROR_NO_GLX_DISPLAY)
+        err = GLEW_OK;
+#endif
+    if (err != GLEW_OK) {
+        cout << "Error: Failed to initialise GLEW : "<< glewGetErrorString(err) << endl;
+        return false;
+    }
+#endif
+    return true;
+}
+
+/* The whole of a file, as it is on disk */
+static std::string readFile (const char* path)
+{
+	std::ifstream stream(path, std::ios::in | std::ios::binary);
+	if (!stream.is_open())
+		cout << "Error: Can't read " << path << endl;
+	return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+}
+
+/* Compile one shader; its log is only printed if that fails */
+static GLuint compileShader (GLenum type, const char* path, const std::string& code)
+{
+	GLuint ShaderID = glCreateShader(type);
+	char const * SourcePointer = code.c_str();
+	glShaderSource(ShaderID, 1, &SourcePointer , NULL);
+	glCompileShader(ShaderID);
+
+	GLint Result = GL_FALSE;
+	glGetShaderiv(ShaderID, GL_COMPILE_STATUS, &Result);
+	if (!Result) {
+		int InfoLogLength = 0;
+		glGetShaderiv(ShaderID, GL_INFO_LOG_LENGTH, &InfoLogLength);
+		std::vector<char> ShaderErrorMessage( max(InfoLogLength, int(1)) );
+		glGetShaderInfoLog(ShaderID, InfoLogLength, NULL, &ShaderErrorMessage[0]);
+		fprintf(stdout, "Compiling shader %s failed:\n%s\n", path, &ShaderErrorMessage[0]);
+	}
+	return ShaderID;
+}
+
+/* Function to load Shaders - Use it as it is. The linked program is kept
+   in 'programcache' (programcache.h), and taken from there while the
+   sources and the driver stay the same. */
+GLuint LoadShaders(const char * vertex_file_path,const char * fragment_file_path) {
+
+	// Read the shader code from the files
+	std::string VertexShaderCode = readFile(vertex_file_path);
+	std::string FragmentShaderCode = readFile(fragment_file_path);
+
+	bool cache = programCacheUsable();
+	unsigned long long key = 0;
+	if (cache) {
+		key = programKey(VertexShaderCode, FragmentShaderCode);
+		GLuint ProgramID = loadCachedProgram(key);
+		if (ProgramID) {
+			cout << "SHADERS: loaded from " << programcache << endl;
+			return ProgramID;
+		}
+	}
+
+	// Compile the shaders
+	GLuint VertexShaderID = compileShader(GL_VERTEX_SHADER, vertex_file_path, VertexShaderCode);
+	GLuint FragmentShaderID = compileShader(GL_FRAGMENT_SHADER, fragment_file_path, FragmentShaderCode);
+
+	// Link the program
+	GLuint ProgramID = glCreateProgram();
+	glAttachShader(ProgramID, VertexShaderID);
+	glAttachShader(ProgramID, FragmentShaderID);
+	if (cache)
+		glProgramParameteri(ProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(ProgramID);
+
+	// Check the program
+	GLint Result = GL_FALSE;
+	glGetProgramiv(ProgramID, GL_LINK_STATUS, &Result);
+	if (!Result) {
+		int InfoLogLength = 0;
+		glGetProgramiv(ProgramID, GL_INFO_LOG_LENGTH, &InfoLogLength);
+		std::vector<char> ProgramErrorMessage( max(InfoLogLength, int(1)) );
+		glGetProgramInfoLog(ProgramID, InfoLogLength, NULL, &ProgramErrorMessage[0]);
+		fprintf(stdout, "Linking program failed:\n%s\n", &ProgramErrorMessage[0]);
+	}
+	else if (cache) {
+		saveCachedProgram(key, ProgramID);
+		cout << "SHADERS: compiled, saved to " << programcache << endl;
+	}
+
+	glDeleteShader(VertexShaderID);
+	glDeleteShader(FragmentShaderID);
+
+	return ProgramID;
+}
+
+void setTransform (struct Transform* t, float x, float y, float angle)
+{
+    if (t->modelok && x == t->x && y == t->y && angle == t->angle)
+        return;
+    t->x = x;
+    t->y = y;
+    t->angle = angle;
+    t->modelok = false;
+}
+
+const glm::mat4& transformMVP (struct Transform* t, const glm::mat4& VP, unsigned vpversion)
+{
+    if (t->modelok && t->vpversion == vpversion)
+        return t->mvp;
+    if (!t->modelok)
+    {
+        glm::mat4 translate = glm::translate (glm::vec3(t->x, t->y, 0));
+        glm::mat4 rotate = glm::rotate((float)(t->angle*M_PI/180.0f), glm::vec3(0,0,1));
+        t->model = translate * rotate;
+        t->modelok = true;
+    }
+    t->mvp = VP * t->model; // MVP = p * V * M
+    t->vpversion = vpversion;
+    return t->mvp;
+}
+
+void packColor (PackedColor c, GLfloat red, GLfloat green, GLfloat blue)
+{
+    c[0] = (GLubyte)(red*255 + 0.5f);
+    c[1] = (GLubyte)(green*255 + 0.5f);
+    c[2] = (GLubyte)(blue*255 + 0.5f);
+    c[3] = 255;
+}
+
+/* Generate VAO, VBOs and return VAO handle */
+struct VAO* create3DObject (GLenum primitive_mode, int numVertices, const struct Vertex* vertices, int numIndices, const GLushort* indices, GLenum fill_mode)
+{
+    struct VAO* vao = new struct VAO;
+    vao->Instanced = false;
+    vao->PrimitiveMode = primitive_mode;
+    vao->NumVertices = numVertices;
+    vao->NumIndices = numIndices;
+    vao->FillMode = fill_mode;
+
+    // Create Vertex Array Object
+    glGenVertexArrays(1, &(vao->VertexArrayID)); // VAO
+    glGenBuffers (1, &(vao->VertexBuffer)); // VBO - vertices, position and colour interleaved
+    glGenBuffers (1, &(vao->IndexBuffer));  // IBO - indices
+
+    stateBindVertexArray (vao->VertexArrayID); // Bind the VAO 
+    stateBindArrayBuffer (vao->VertexBuffer); // Bind the VBO vertices 
+    glBufferData (GL_ARRAY_BUFFER, numVertices*sizeof(struct Vertex), vertices, GL_STATIC_DRAW); // Copy the vertices into VBO
+    glVertexAttribPointer(
+                          0,                  // attribute 0. Vertices
+                          2,                  // size (x,y)
+                          GL_FLOAT,           // type
+                          GL_FALSE,           // normalized?
+                          sizeof(struct Vertex), // stride
+                          (void*)0            // array buffer offset
+                          );
+    glVertexAttribPointer(
+                          1,                  // attribute 1. Color
+                          4,                  // size (r,g,b,a)
+                          GL_UNSIGNED_BYTE,   // type
+                          GL_TRUE,            // normalized?
+                          sizeof(struct Vertex), // stride
+                          (void*)offsetof(struct Vertex, color) // array buffer offset
+                          );
+
+    // The index buffer binding belongs to the VAO
+    glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, vao->IndexBuffer);
+    glBufferData (GL_ELEMENT_ARRAY_BUFFER, numIndices*sizeof(GLushort), indices, GL_STATIC_DRAW);
+
+    return vao;
+}
+
+/* The two triangles of a quad, sharing the diagonal from corner 0 to 2 */
+static const GLushort quad_indices[6] = { 0, 1, 2,  2, 3, 0 };
+
+/* Generate VAO, VBOs and return VAO handle - Common Color for all vertices */
+struct VAO* createQuad (const GLfloat corners[8], GLfloat red, GLfloat green, GLfloat blue, GLenum fill_mode)
+{
+    struct Vertex vertices[4];
+    for (int i=0; i<4; i++) {
+        vertices[i].x = corners[2*i];
+        vertices[i].y = corners[2*i + 1];
+        packColor(vertices[i].color, red, green, blue);
+    }
+
+    return create3DObject(GL_TRIANGLES, 4, vertices, 6, quad_indices, fill_mode);
+}
+
+/* Add a quad, as createQuad() takes it, placed by 'model' */
+void batchQuad (struct MeshBatch* batch, const GLfloat corners[8], GLfloat red, GLfloat green, GLfloat blue, const glm::mat4& model)
+{
+    GLushort first = batch->vertices.size();
+    for (int i=0; i<4; i++) {
+        glm::vec4 p = model * glm::vec4(corners[2*i], corners[2*i + 1], 0, 1);
+        struct Vertex v;
+        v.x = p.x;
+        v.y = p.y;
+        packColor(v.color, red, green, blue);
+        batch->vertices.push_back(v);
+    }
+
+    for (int i=0; i<6; i++)
+        batch->indices.push_back(first + quad_indices[i]);
+}
+
+struct VAO* createBatch (const struct MeshBatch* batch, GLenum fill_mode)
+{
+    return create3DObject(GL_TRIANGLES, batch->vertices.size(), &batch->vertices[0], batch->indices.size(), &batch->indices[0], fill_mode);
+}
+
+struct VAO* getMesh (const string& name, struct VAO* (*create)())
+{
+    static map<string, struct VAO*> meshcache;
+    map<string, struct VAO*>::iterator it = meshcache.find(name);
+    if (it != meshcache.end())
+        return it->second;
+
+    struct VAO* vao = create();
+    meshcache[name] = vao;
+    return vao;
+}
+
+/* Render the VBOs handled by VAO */
+void draw3DObject (struct VAO* vao)
+{
+    // Change the Fill Mode for this object
+    statePolygonMode (vao->FillMode);
+
+    // Bind the VAO to use
+    stateBindVertexArray (vao->VertexArrayID);
+
+    // Enable Vertex Attribute 0 - 2d Vertices, and 1 - Color. The VAO
+    // remembers which buffer each comes from, so neither is bound here.
+    stateEnableAttrib(0);
+    stateEnableAttrib(1);
+
+    // Draw the geometry !
+    glDrawElements(vao->PrimitiveMode, vao->NumIndices, GL_UNSIGNED_SHORT, (void*)0); // Indices from the VAO's index buffer
+}
+
+/* Per-frame data, written straight into buffer memory */
+static struct StreamBuffer framestream;
+static GLintptr instanceoffset;
+
+void initStreaming (bool persistent)
+{
+    initStreamBuffer (&framestream, 64*1024, persistent);
+    cout << "STREAMING: " << (framestream.persistent ? "persistent mapping" : "orphaning") << endl;
+}
+
+/* Feed attribute 1 (colour) and attribute 2 (offset) of the VAO from the
+   frame's instance data, so many copies can be drawn in one call */
+void makeInstanced (struct VAO* vao)
+{
+    vao->Instanced = true;
+    stateBindVertexArray (vao->VertexArrayID);
+    stateEnableAttrib(0);
+    stateEnableAttrib(1);
+    glVertexAttribDivisor(1, 1); // advance once per instance, not per vertex
+    stateEnableAttrib(2);
+    glVertexAttribDivisor(2, 1);
+}
+
+struct Instance* mapInstances (int count)
+{
+    return (struct Instance*) streamAlloc (&framestream, count*sizeof(struct Instance), &instanceoffset);
+}
+
+/* Render 'count' copies of the VAO, one per entry just written to
+   mapInstances() */
+void draw3DObjectInstanced (struct VAO* vao, int count)
+{
+    streamCommit (&framestream);
+    if (count == 0)
+        return;
+
+    statePolygonMode (vao->FillMode);
+    stateBindVertexArray (vao->VertexArrayID);
+
+    // The data moves around the buffer from frame to frame
+    stateBindArrayBuffer (framestream.buffer);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(struct Instance), (void*)(instanceoffset + offsetof(struct Instance, color)));
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(struct Instance), (void*)instanceoffset);
+
+    glDrawElementsInstanced(vao->PrimitiveMode, vao->NumIndices, GL_UNSIGNED_SHORT, (void*)0, count);
+}
+
+void renderFrameEnd ()
+{
+    streamFrameEnd (&framestream);
+    stateFrameEnd ();
+}
+
+/* GPU time of each frame, measured with GL_TIME_ELAPSED queries. A query
+   is read back GPU_TIMER_FRAMES frames after it was issued, by which
+   time the result is normally there, so reading it never stalls. */
+#define GPU_TIMER_FRAMES 4
+static GLuint gputimers[GPU_TIMER_FRAMES];
+static bool gputimerissued[GPU_TIMER_FRAMES];
+static unsigned gputimerframe[GPU_TIMER_FRAMES];
+static int gputimernext = -1;
+
+void gpuTimerBegin ()
+{
+    if (!profileEnabled())
+        return;
+    if (gputimernext < 0)
+    {
+        glGenQueries (GPU_TIMER_FRAMES, gputimers);
+        gputimernext = 0;
+    }
+
+    GLuint q = gputimers[gputimernext];
+    if (gputimerissued[gputimernext])
+    {
+        GLint available = 0;
+        glGetQueryObjectiv (q, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available)
+        {
+            GLuint64 ns;
+            glGetQueryObjectui64v (q, GL_QUERY_RESULT, &ns);
+            profileRecordAt (PROF_GPU, gputimerframe[gputimernext], (long long)ns);
+        }
+    }
+    glBeginQuery (GL_TIME_ELAPSED, q);
+    gputimerissued[gputimernext] = true;
+    gputimerframe[gputimernext] = profileFrameNo();
+}
+
+void gpuTimerEnd ()
+{
+    if (!profileEnabled() || gputimernext < 0)
+        return;
+    glEndQuery (GL_TIME_ELAPSED);
+    gputimernext = (gputimernext+1) % GPU_TIMER_FRAMES;
+}
+
@@ -0,0 +1,121 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+/* GL objects and drawing shared by the GLUT and GLFW frontends. The GL
+   functions come from GLEW, or from glad when built with -DUSE_GLAD (as
+   the GLFW frontend is). Nothing here knows about windows or the game. */
+
+/* GL_HAS(ARB_buffer_storage) is true if the context has the extension */
+#ifdef USE_GLAD
+#include <glad/glad.h>
+#define GL_HAS(ext) GLAD_GL_##ext
+#else
+#include <GL/glew.h>
+#define GL_HAS(ext) GLEW_##ext
+#endif
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <string>
+#include <vector>
+
+struct VAO {
+    GLuint VertexArrayID;
+    GLuint VertexBuffer;
+    GLuint IndexBuffer;
+    bool Instanced; // drawn with draw3DObjectInstanced
+
+    GLenum PrimitiveMode;
+    GLenum FillMode;
+    int NumVertices;
+    int NumIndices;
+};
+typedef struct VAO VAO;
+
+struct GLMatrices {
+    glm::mat4 projection;
+    glm::mat4 model;
+    glm::mat4 view;
+    GLuint MatrixID;
+};
+extern struct GLMatrices Matrices;
+
+/* Where an object is drawn: moved to (x, y) and turned 'angle' degrees
+   about z. Its model and MVP matrices are kept, and rebuilt only when
+   setTransform() changes it or the view-projection is a new one; a
+   zeroed Transform has neither built yet. */
+struct Transform {
+    float x, y, angle;
+    glm::mat4 model;
+    glm::mat4 mvp;
+    bool modelok; // model is built from x, y, angle
+    unsigned vpversion; // of the view-projection mvp was built with
+};
+void setTransform(struct Transform* t, float x, float y, float angle);
+/* 'vpversion' changes whenever 'VP' does */
+const glm::mat4& transformMVP(struct Transform* t, const glm::mat4& VP, unsigned vpversion);
+
+/* A colour as 0-255 per channel, read by the shader as 0-1; alpha unused */
+typedef GLubyte PackedColor[4];
+void packColor(PackedColor c, GLfloat red, GLfloat green, GLfloat blue);
+
+/* One vertex of a mesh, interleaved: 12 bytes where a float position and
+   colour took 24. Meshes lie in the z=0 plane. */
+struct Vertex {
+    GLfloat x, y;
+    PackedColor color;
+};
+
+/* Per-instance data: an offset added to every vertex and a flat colour */
+struct Instance {
+    GLfloat x, y;
+    PackedColor color;
+};
+
+/* Load the GL functions for the current context. 'getproc' looks them up
+   (glfwGetProcAddress, eglGetProcAddress); GLEW finds them itself. */
+typedef void* (*GLGetProc)(const char* name);
+bool loadGL(GLGetProc getproc);
+
+GLuint LoadShaders(const char* vertex_file_path, const char* fragment_file_path);
+
+/* Meshes are indexed; 'indices' picks 'numIndices' of the vertices in
+   the order 'primitive_mode' takes them */
+struct VAO* create3DObject(GLenum primitive_mode, int numVertices, const struct Vertex* vertices, int numIndices, const GLushort* indices, GLenum fill_mode=GL_FILL);
+/* A quad of one colour from its four corners (x,y), in order around it:
+   four vertices and two triangles sharing the 1st-3rd diagonal */
+struct VAO* createQuad(const GLfloat corners[8], GLfloat red, GLfloat green, GLfloat blue, GLenum fill_mode=GL_FILL);
+void draw3DObject(struct VAO* vao);
+
+/* Geometry that never moves, put into world space once so all of it is
+   drawn in one call with the view-projection matrix alone */
+struct MeshBatch {
+    std::vector<struct Vertex> vertices;
+    std::vector<GLushort> indices;
+};
+void batchQuad(struct MeshBatch* batch, const GLfloat corners[8], GLfloat red, GLfloat green, GLfloat blue, const glm::mat4& model);
+struct VAO* createBatch(const struct MeshBatch* batch, GLenum fill_mode=GL_FILL);
+
+/* Meshes shared between objects, created on first use and never freed */
+struct VAO* getMesh(const std::string& name, struct VAO* (*create)());
+
+/* Per-frame data goes into a stream buffer (streambuffer.h), persistently
+   mapped if 'persistent' and the driver can; initStreaming() comes after
+   loadGL(), and renderFrameEnd() after each frame's last draw. */
+void initStreaming(bool persistent);
+void renderFrameEnd();
+
+/* Instanced drawing: write 'count' instances to mapInstances(count),
+   then draw them */
+void makeInstanced(struct VAO* vao);
+struct Instance* mapInstances(int count);
+void draw3DObjectInstanced(struct VAO* vao, int count);
+
+/* GPU time of each frame, recorded as PROF_GPU while profiling */
+void gpuTimerBegin();
+void gpuTimerEnd();
+
+#endif
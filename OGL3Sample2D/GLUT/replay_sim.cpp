@@ -0,0 +1,98 @@
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+
+#include "brickworld.h"
+#include "inputlog.h"
+#include "profile.h"
+
+/* Plays a game recorded with sample2D --record=FILE back through the game
+   rules, with no window and as fast as it will go, and prints how the game
+   ended along with a checksum of the final state. Two replays of the same
+   recording must print the same checksum. A damaged recording is played
+   up to its first bad command and then reported, with exit status 1.
+
+   usage: replay_sim FILE [--profile] */
+
+/* FNV-1a over the parts of the world a replay has to reproduce */
+static unsigned long long checksum (const BrickWorld& world)
+{
+	unsigned long long h=14695981039346656037ULL;
+	const unsigned char* p;
+	size_t k;
+	int j;
+
+#define HASH(v) for (p=(const unsigned char*)&(v),k=0;k<sizeof(v);k++) h=(h^p[k])*1099511628211ULL
+	HASH(world.score);
+	HASH(world.lives);
+	HASH(world.gameover);
+	HASH(world.ticks);
+	HASH(world.cannon);
+	HASH(world.buck);
+	HASH(world.laser.x);
+	HASH(world.laser.y);
+	HASH(world.laser.laser_rotation);
+	for (j=0;j<world.bricks.live;j++)
+	{
+		int i=world.bricks.livelist[j];
+		HASH(world.bricks.x[i]);
+		HASH(world.bricks.y[i]);
+		HASH(world.bricks.col[i]);
+	}
+#undef HASH
+	return h;
+}
+
+int main (int argc, char** argv)
+{
+	const char* path=NULL;
+	bool usage=false;
+	int i;
+
+	for (i=1;i<argc;i++)
+	{
+		if (strcmp(argv[i],"--profile")==0)
+			profileStart(NULL);
+		else if (argv[i][0]!='-' && !path)
+			path=argv[i];
+		else
+			usage=true;
+	}
+	if (!path || usage)
+	{
+		fprintf(stderr,"usage: %s FILE [--profile]\n",argv[0]);
+		return 1;
+	}
+
+	struct InputReplay replay;
+	if (!replay.open(path))
+	{
+		fprintf(stderr,"%s: not a recording\n",path);
+		return 1;
+	}
+
+	static BrickWorld world;
+	BrickInputs in;
+	world.init(replay.seed);
+
+	std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+	while (replay.read(world.ticks,in) && !world.gameover)
+		world.step(in);
+	std::chrono::steady_clock::time_point end=std::chrono::steady_clock::now();
+	replay.close();
+	if (replay.corrupt)
+	{
+		fprintf(stderr,"%s: damaged recording, a bad command at step %u\n",path,replay.end);
+		return 1;
+	}
+
+	double secs=std::chrono::duration<double>(end-start).count();
+	printf("seed      %llu\n",replay.seed);
+	printf("ticks     %u\n",world.ticks);
+	printf("score     %d\n",world.score);
+	printf("lives     %d\n",world.lives);
+	printf("gameover  %d\n",world.gameover);
+	printf("checksum  %016llx\n",checksum(world));
+	printf("time      %.3f s (%.0f ticks/s, %.0fx real time)\n",secs,world.ticks/secs,world.ticks/secs/BRICK_TICK_RATE);
+	return 0;
+}
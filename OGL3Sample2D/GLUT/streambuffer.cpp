@@ -0,0 +1,128 @@
+#include <cstring>
+
+#include "streambuffer.h"
+#include "glstate.h"
+
+/* Offsets handed out are kept this aligned, more than any attribute needs */
+#define STREAM_ALIGN 16
+
+static void createStorage (struct StreamBuffer* s)
+{
+	glGenBuffers (1, &s->buffer);
+	stateBindArrayBuffer (s->buffer);
+	if (s->persistent)
+	{
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage (GL_ARRAY_BUFFER, STREAM_REGIONS*s->size, NULL, flags);
+		s->mapped = (unsigned char*) glMapBufferRange (GL_ARRAY_BUFFER, 0, STREAM_REGIONS*s->size, flags);
+		if (s->mapped)
+			return;
+		// Storage is immutable, so orphaning needs a buffer of its own
+		stateDeleteBuffer (s->buffer);
+		glGenBuffers (1, &s->buffer);
+		stateBindArrayBuffer (s->buffer);
+		s->persistent = false;
+	}
+	glBufferData (GL_ARRAY_BUFFER, s->size, NULL, GL_STREAM_DRAW);
+}
+
+void initStreamBuffer (struct StreamBuffer* s, GLsizeiptr size, bool persistent)
+{
+	memset(s, 0, sizeof(*s));
+	s->size = (size+STREAM_ALIGN-1) & ~(GLsizeiptr)(STREAM_ALIGN-1);
+	s->persistent = persistent && GL_HAS(ARB_buffer_storage);
+	createStorage(s);
+}
+
+/* Replace the buffer with one whose regions hold at least 'size' bytes.
+   Draws already made from the old one still see it; GL frees it after. */
+static void grow (struct StreamBuffer* s, GLsizeiptr size)
+{
+	GLsizeiptr newsize = s->size;
+	while (newsize < size)
+		newsize *= 2;
+
+	int i;
+	if (s->persistent)
+	{
+		stateBindArrayBuffer (s->buffer);
+		glUnmapBuffer (GL_ARRAY_BUFFER);
+	}
+	for (i = 0; i < STREAM_REGIONS; i++)
+	{
+		if (s->fences[i])
+			glDeleteSync (s->fences[i]);
+		s->fences[i] = 0;
+	}
+	stateDeleteBuffer (s->buffer);
+
+	s->size = newsize;
+	s->region = 0;
+	s->used = 0;
+	createStorage(s);
+}
+
+/* Wait until the GPU is done with the region about to be written. With
+   STREAM_REGIONS frames in flight this hardly ever waits at all. */
+static void waitRegion (struct StreamBuffer* s)
+{
+	GLsync fence = s->fences[s->region];
+	if (!fence)
+		return;
+	GLbitfield flags = 0;
+	while (glClientWaitSync (fence, flags, 1000000000) == GL_TIMEOUT_EXPIRED)
+		flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+	glDeleteSync (fence);
+	s->fences[s->region] = 0;
+}
+
+void* streamAlloc (struct StreamBuffer* s, GLsizeiptr bytes, GLintptr* offset)
+{
+	GLsizeiptr start = (s->used+STREAM_ALIGN-1) & ~(GLsizeiptr)(STREAM_ALIGN-1);
+	if (start+bytes > s->size)
+	{
+		grow(s, start+bytes);
+		start = 0;
+	}
+	else if (!s->started && s->persistent)
+		waitRegion(s);
+
+	s->started = true;
+	s->used = start+bytes;
+	if (s->persistent)
+	{
+		*offset = s->region*s->size + start;
+		return s->mapped + *offset;
+	}
+
+	stateBindArrayBuffer (s->buffer);
+	if (start == 0)
+		glBufferData (GL_ARRAY_BUFFER, s->size, NULL, GL_STREAM_DRAW); // orphan
+	*offset = start;
+	if (bytes == 0)
+		return s->mapped;
+	s->writing = true;
+	return glMapBufferRange (GL_ARRAY_BUFFER, start, bytes,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+}
+
+void streamCommit (struct StreamBuffer* s)
+{
+	stateBindArrayBuffer (s->buffer);
+	if (s->writing)
+		glUnmapBuffer (GL_ARRAY_BUFFER);
+	s->writing = false;
+}
+
+void streamFrameEnd (struct StreamBuffer* s)
+{
+	if (!s->started)
+		return;
+	if (s->persistent)
+	{
+		s->fences[s->region] = glFenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		s->region = (s->region+1) % STREAM_REGIONS;
+	}
+	s->used = 0;
+	s->started = false;
+}
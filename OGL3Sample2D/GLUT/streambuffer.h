@@ -0,0 +1,47 @@
+#ifndef STREAMBUFFER_H
+#define STREAMBUFFER_H
+
+#include "renderer.h"
+
+/* A vertex buffer for data written anew every frame, written in place
+   rather than copied in with glBufferSubData.
+
+   Where glBufferStorage is there (GL 4.4, ARB_buffer_storage), the buffer
+   holds STREAM_REGIONS frames and stays mapped for good; each frame
+   writes the next region, after waiting on the fence set when the GPU was
+   last given that region, which it has normally long finished with.
+   Elsewhere the buffer is orphaned at the start of each frame and written
+   through unsynchronised glMapBufferRange calls.
+
+   Either way nothing waits on the GPU's use of earlier frames, and
+   nothing is allocated once the buffer is as large as a frame needs. */
+
+#define STREAM_REGIONS 3
+
+struct StreamBuffer {
+	GLuint buffer;
+	GLsizeiptr size;		// bytes in each region
+	bool persistent;		// mapped for good; orphaned each frame if not
+	unsigned char* mapped;		// all regions, while persistent
+	GLsync fences[STREAM_REGIONS];
+	int region;			// written this frame
+	GLsizeiptr used;		// bytes of it handed out so far
+	bool started;			// something was handed out this frame
+	bool writing;			// a range is mapped (orphaning only)
+};
+
+/* 'persistent' asks for persistent mapping; it falls back to orphaning
+   without glBufferStorage */
+void initStreamBuffer(struct StreamBuffer* s, GLsizeiptr size, bool persistent);
+
+/* Space for 'bytes' of this frame's data, at '*offset' in s->buffer. The
+   buffer is replaced by a larger one if the frame needs more room, so
+   call streamCommit() once the data is written and draw from it before
+   asking for more. */
+void* streamAlloc(struct StreamBuffer* s, GLsizeiptr bytes, GLintptr* offset);
+void streamCommit(struct StreamBuffer* s);
+
+/* After the last draw of the frame that reads from the buffer */
+void streamFrameEnd(struct StreamBuffer* s);
+
+#endif
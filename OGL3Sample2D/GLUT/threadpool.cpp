@@ -0,0 +1,156 @@
+#include "threadpool.h"
+
+ThreadPool::ThreadPool (int n)
+	: slices(n>0 ? n : (std::thread::hardware_concurrency()>0 ? std::thread::hardware_concurrency() : 1))
+{
+	nthreads=(int)slices.size();
+	task=0;
+	ctx=0;
+	remaining=0;
+	generation=0;
+	stopping=false;
+
+	int i;
+	for (i=0;i<nthreads;i++)
+	{
+		slices[i].begin=slices[i].end=0;
+		slices[i].grain=1;
+	}
+	/* Slot 0 belongs to whoever calls parallelFor() */
+	for (i=1;i<nthreads;i++)
+		threads.push_back(std::thread(&ThreadPool::worker,this,i));
+}
+
+ThreadPool::~ThreadPool ()
+{
+	{
+		std::lock_guard<std::mutex> g(lock);
+		stopping=true;
+	}
+	wake.notify_all();
+	size_t i;
+	for (i=0;i<threads.size();i++)
+		threads[i].join();
+}
+
+/* Run task(ctx, begin, end) over [0, n) and return once all of it is done */
+void ThreadPool::parallelFor (int n, int g, PoolTask t, void* c)
+{
+	if (n<=0)
+		return;
+
+	task=t;
+	ctx=c;
+	remaining=n;
+	/* A worker still finishing the last loop can already steal from the
+	   slices set so far, and would keep the rest of what it stole in its
+	   own slice, which is then overwritten. Holding every slice's lock
+	   while setting them all keeps it out until they are. A thief takes
+	   its two with std::lock, never waiting while it holds one, so taking
+	   them all in order can't deadlock. */
+	int i;
+	for (i=0;i<nthreads;i++)
+		slices[i].lock.lock();
+	for (i=0;i<nthreads;i++)
+	{
+		slices[i].begin=(int)((long long)n*i/nthreads);
+		slices[i].end=(int)((long long)n*(i+1)/nthreads);
+		slices[i].grain=g>0 ? g : 1;
+	}
+	for (i=0;i<nthreads;i++)
+		slices[i].lock.unlock();
+	{
+		std::lock_guard<std::mutex> s(lock);
+		generation++;
+	}
+	wake.notify_all();
+
+	work(0);
+
+	std::unique_lock<std::mutex> s(lock);
+	while (remaining.load()>0)
+		done.wait(s);
+}
+
+void ThreadPool::worker (int self)
+{
+	unsigned seen=0;
+	while (1)
+	{
+		{
+			std::unique_lock<std::mutex> s(lock);
+			while (!stopping && generation==seen)
+				wake.wait(s);
+			if (stopping)
+				return;
+			seen=generation;
+		}
+		work(self);
+	}
+}
+
+/* Run chunks until there is nothing left to take or steal */
+void ThreadPool::work (int self)
+{
+	int b, e;
+	while (take(self,&b,&e))
+	{
+		task(ctx,b,e);
+		if (remaining.fetch_sub(e-b)==e-b)
+		{
+			std::lock_guard<std::mutex> s(lock);
+			done.notify_all();
+		}
+	}
+}
+
+/* The next chunk from the front of slice 'slice', which must be locked */
+static bool front (struct PoolSlice& slice, int* b, int* e)
+{
+	if (slice.begin>=slice.end)
+		return false;
+	*b=slice.begin;
+	*e=slice.begin+slice.grain<slice.end ? slice.begin+slice.grain : slice.end;
+	slice.begin=*e;
+	return true;
+}
+
+/* Next chunk for worker 'self': from its own slice if there is any left,
+   otherwise stolen from the back of another's */
+bool ThreadPool::take (int self, int* b, int* e)
+{
+	struct PoolSlice& own = slices[self];
+	{
+		std::lock_guard<std::mutex> s(own.lock);
+		if (front(own,b,e))
+			return true;
+	}
+
+	int k;
+	for (k=1;k<nthreads;k++)
+	{
+		struct PoolSlice& victim = slices[(self+k)%nthreads];
+
+		/* Both locked at once: the next loop may have refilled the own
+		   slice since it was found empty, and the stolen half must not
+		   land on top of that */
+		std::unique_lock<std::mutex> o(own.lock,std::defer_lock);
+		std::unique_lock<std::mutex> v(victim.lock,std::defer_lock);
+		std::lock(o,v);
+		if (front(own,b,e))
+			return true;
+		if (victim.begin>=victim.end)
+			continue;
+
+		/* Move the back half into the own slice, all of it if it is no
+		   more than a chunk, and run its first chunk */
+		int left=victim.end-victim.begin;
+		int split=left<=victim.grain ? victim.begin : victim.begin+left/2;
+		own.begin=split;
+		own.end=victim.end;
+		own.grain=victim.grain;
+		victim.end=split;
+		return front(own,b,e);
+	}
+	return false;
+}
@@ -0,0 +1,52 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+/* Work-stealing pool for running a loop over many independent items, such
+   as worlds to step. parallelFor() hands each worker, the calling thread
+   included, an equal slice of the items. A worker takes 'grain' items at
+   a time from the front of its own slice, and a worker whose slice is
+   used up steals the back half of another's. Cheap and expensive items
+   even out without any central queue. */
+
+typedef void (*PoolTask)(void* ctx, int begin, int end);
+
+struct PoolSlice {
+	std::mutex lock;
+	int begin;		// items not yet taken
+	int end;
+	int grain;		// items to take at a time
+};
+
+struct ThreadPool {
+	int nthreads;		// workers, counting the thread calling parallelFor()
+	std::vector<std::thread> threads;
+	std::vector<PoolSlice> slices;
+
+	/* The loop being run */
+	PoolTask task;
+	void* ctx;
+	std::atomic<int> remaining;	// items not yet finished
+
+	std::mutex lock;
+	std::condition_variable wake;	// a loop started, or the pool is stopping
+	std::condition_variable done;	// remaining reached 0
+	unsigned generation;
+	bool stopping;
+
+	ThreadPool(int threads);	// 0 for one per core
+	~ThreadPool();
+	void parallelFor(int n, int grain, PoolTask task, void* ctx);
+
+private:
+	void worker(int self);
+	void work(int self);
+	bool take(int self, int* begin, int* end);
+};
+
+#endif
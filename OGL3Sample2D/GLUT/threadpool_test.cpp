@@ -0,0 +1,66 @@
+#include <cstdio>
+#include <vector>
+#include <atomic>
+
+#include "threadpool.h"
+
+/* Runs the pool over every loop length from 1 to 1000 with grains of 1, 3
+   and 64 on 1 to 8 threads, and checks that each index of [0, n) is run
+   exactly once and nothing outside it is. Lengths that don't divide into
+   slices and chunks evenly are what make workers steal odd-sized pieces.
+
+   usage: threadpool_test		exits 1 on the first failure */
+
+#define MAX_N 1000
+
+struct Counts {
+	std::atomic<int> runs[MAX_N+1];
+	std::atomic<int> outside;	// indices handed out beyond n
+	int n;
+};
+
+static void count (void* ctx, int begin, int end)
+{
+	struct Counts* c = (struct Counts*)ctx;
+	int i;
+	if (begin<0 || end>c->n || begin>=end)
+		c->outside++;
+	for (i=begin;i<end;i++)
+		if (i>=0 && i<c->n)
+			c->runs[i]++;
+}
+
+int main ()
+{
+	static const int grains[]={ 1, 3, 64 };
+	static struct Counts c;
+	int threads, g, n, i, loops=0;
+
+	for (threads=1;threads<=8;threads++)
+	{
+		ThreadPool pool(threads);
+		for (g=0;g<3;g++)
+			for (n=1;n<=MAX_N;n++)
+			{
+				c.n=n;
+				c.outside=0;
+				for (i=0;i<n;i++)
+					c.runs[i]=0;
+				pool.parallelFor(n,grains[g],count,&c);
+				loops++;
+				if (c.outside>0)
+				{
+					printf("FAIL: threads=%d grain=%d n=%d: %d chunks out of range\n",threads,grains[g],n,c.outside.load());
+					return 1;
+				}
+				for (i=0;i<n;i++)
+					if (c.runs[i]!=1)
+					{
+						printf("FAIL: threads=%d grain=%d n=%d: index %d ran %d times\n",threads,grains[g],n,i,c.runs[i].load());
+						return 1;
+					}
+			}
+	}
+	printf("ok: %d loops, every index run exactly once\n",loops);
+	return 0;
+}